@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include <moment/Signal.hpp>
+
+namespace {
+
+void slot(int x)
+{
+    benchmark::DoNotOptimize(x);
+}
+
+} // namespace
+
+namespace moment {
+
+/// Connect and disconnect one slot on a signal that already has range(0) connections.
+template <typename Policy>
+void BM_ConnectDisconnect(benchmark::State& state)
+{
+    Signal<void(int), Policy> sig{};
+    for (auto i = 0; i < state.range(0); ++i) {
+        sig.connect(&slot);
+    }
+    for (auto _ : state) {
+        auto connection = sig.connect(&slot);
+        connection.disconnect();
+    }
+}
+BENCHMARK_TEMPLATE(BM_ConnectDisconnect, multi_threaded)->Arg(0)->Arg(1000)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_ConnectDisconnect, single_threaded)->Arg(0)->Arg(1000)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_ConnectDisconnect, lock_free)->Arg(0)->Arg(1000)->Arg(10000);
+
+/// Connect a one shot slot and emit it, e.g. request / response correlation.
+template <typename Policy>
+void BM_ConnectOnceEmit(benchmark::State& state)
+{
+    Signal<void(int), Policy> sig{};
+    for (auto _ : state) {
+        sig.connectOnce(&slot);
+        sig(1);
+    }
+}
+BENCHMARK_TEMPLATE(BM_ConnectOnceEmit, multi_threaded);
+BENCHMARK_TEMPLATE(BM_ConnectOnceEmit, single_threaded);
+BENCHMARK_TEMPLATE(BM_ConnectOnceEmit, lock_free);
+
+/// Disconnect connections in a random order from a signal with range(0) connections.
+void BM_DisconnectChurn(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    Signal<void(int)> sig{};
+    auto connections = std::vector<Connection<void(int)>>{};
+    connections.reserve(count);
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (auto i = 0u; i < count; ++i) {
+            connections.push_back(sig.connect(&slot));
+        }
+        /// Stride through the connections so disconnects are spread out over the list
+        state.ResumeTiming();
+        for (auto offset = 0u; offset < 7u; ++offset) {
+            for (auto i = offset; i < count; i += 7u) {
+                connections[i].disconnect();
+            }
+        }
+        state.PauseTiming();
+        connections.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DisconnectChurn)->Arg(1000)->Arg(10000);
+
+/// Connect range(0) slots to a fresh signal and destroy it.
+void BM_ConnectMany(benchmark::State& state)
+{
+    for (auto _ : state) {
+        Signal<void(int)> sig{};
+        for (auto i = 0; i < state.range(0); ++i) {
+            sig.connect(&slot);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ConnectMany)->Arg(1)->Arg(1000)->Arg(100000);
+
+/// Move construct a signal with range(0) connections.
+void BM_MoveSignal(benchmark::State& state)
+{
+    Signal<void(int)> sig{};
+    for (auto i = 0; i < state.range(0); ++i) {
+        sig.connect(&slot);
+    }
+    for (auto _ : state) {
+        Signal<void(int)> moved{std::move(sig)};
+        benchmark::DoNotOptimize(moved);
+        sig = std::move(moved);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_MoveSignal)->Arg(0)->Arg(1000)->Arg(100000);
+
+} // namespace moment
@@ -0,0 +1,370 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <moment/Signal.hpp>
+#include <moment/SignalMap.hpp>
+#include <moment/StaticSignal.hpp>
+
+namespace {
+
+int sink{0};
+
+void slot(int x)
+{
+    benchmark::DoNotOptimize(sink += x);
+}
+
+/// An argument too large to pass in registers
+struct Large {
+    std::array<int, 64> values{};
+};
+
+template <typename T>
+T makeArg();
+
+template <>
+int makeArg<int>()
+{
+    return 1;
+}
+
+template <>
+std::string makeArg<std::string>()
+{
+    return std::string(64, 'x');
+}
+
+template <>
+Large makeArg<Large>()
+{
+    return Large{};
+}
+
+class Receiver {
+public:
+    void onEvent(int x) { benchmark::DoNotOptimize(_total += x); }
+
+private:
+    int _total{0};
+};
+
+} // namespace
+
+/// Emission codegen probe. Disassemble this to inspect the emit path, e.g.
+///     objdump -d --no-show-raw-insn -C bin/bench/moment_bench | grep -A60 '<emitOne'
+/// With one connection the loop body should reduce to the validity check and a single indirect call into the
+/// slot invoker, with no std::function or closure in between.
+__attribute__((noinline)) void emitOne(moment::Signal<void(int)>& sig, int x)
+{
+    sig(x);
+}
+
+namespace moment {
+
+/// Baseline: an indirect call through a function pointer.
+void BM_FunctionPointer(benchmark::State& state)
+{
+    auto func = &slot;
+    benchmark::DoNotOptimize(func);
+    for (auto _ : state) {
+        func(1);
+    }
+}
+BENCHMARK(BM_FunctionPointer);
+
+/// Baseline: a call through the slot type on its own.
+void BM_Delegate(benchmark::State& state)
+{
+    Signal<void(int)>::Slot delegate{&slot};
+    benchmark::DoNotOptimize(delegate);
+    for (auto _ : state) {
+        delegate(1);
+    }
+}
+BENCHMARK(BM_Delegate);
+
+void BM_EmitOneSlot(benchmark::State& state)
+{
+    Signal<void(int)> sig{};
+    sig.connect(&slot);
+    for (auto _ : state) {
+        emitOne(sig, 1);
+    }
+}
+BENCHMARK(BM_EmitOneSlot);
+
+/// Emit cost against the number of connected slots.
+template <typename Policy>
+void BM_Emit(benchmark::State& state)
+{
+    Signal<void(int), Policy> sig{};
+    for (auto i = 0; i < state.range(0); ++i) {
+        sig.connect(&slot);
+    }
+    for (auto _ : state) {
+        sig(1);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Emit, multi_threaded)->Arg(0)->Arg(1)->Arg(8)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_Emit, single_threaded)->Arg(0)->Arg(1)->Arg(8)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_Emit, lock_free)->Arg(0)->Arg(1)->Arg(8)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_Emit, with_metrics<multi_threaded>)->Arg(0)->Arg(1)->Arg(8)->Arg(1000);
+
+/// Emit cost when the connections are spread over the heap, as they are once a program has been running a while.
+/// @note Connecting in a tight loop places the connections next to each other, which hides how many cache lines each
+/// slot call touches.
+void BM_EmitScattered(benchmark::State& state)
+{
+    Signal<void(int)> sig{};
+    auto rng = std::mt19937{42u};
+    auto spacers = std::vector<std::unique_ptr<char[]>>{};
+    for (auto i = 0; i < state.range(0); ++i) {
+        sig.connect(&slot);
+        for (auto spacer = rng() % 8u; spacer > 0u; --spacer) {
+            spacers.emplace_back(new char[16u + rng() % 512u]);
+        }
+    }
+    for (auto _ : state) {
+        sig(1);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EmitScattered)->Arg(1000)->Arg(10000)->Arg(100000);
+
+/// Emit cost against the argument type, slots take their argument by const reference.
+template <typename Arg>
+void BM_EmitArgument(benchmark::State& state)
+{
+    Signal<void(Arg)> sig{};
+    for (auto i = 0; i < 8; ++i) {
+        sig.connect([](const Arg& arg) { benchmark::DoNotOptimize(&arg); });
+    }
+    const auto arg = makeArg<Arg>();
+    for (auto _ : state) {
+        sig(arg);
+    }
+}
+BENCHMARK_TEMPLATE(BM_EmitArgument, int);
+BENCHMARK_TEMPLATE(BM_EmitArgument, std::string);
+BENCHMARK_TEMPLATE(BM_EmitArgument, Large);
+
+/// Emit cost against the argument type, slots take their argument by value.
+template <typename Arg>
+void BM_EmitArgumentByValue(benchmark::State& state)
+{
+    Signal<void(Arg)> sig{};
+    for (auto i = 0; i < 8; ++i) {
+        sig.connect([](Arg arg) { benchmark::DoNotOptimize(&arg); });
+    }
+    const auto arg = makeArg<Arg>();
+    for (auto _ : state) {
+        sig(arg);
+    }
+}
+BENCHMARK_TEMPLATE(BM_EmitArgumentByValue, int);
+BENCHMARK_TEMPLATE(BM_EmitArgumentByValue, std::string);
+BENCHMARK_TEMPLATE(BM_EmitArgumentByValue, Large);
+
+/// Emit cost against the way the slot was connected.
+void BM_EmitLambda(benchmark::State& state)
+{
+    Signal<void(int)> sig{};
+    Receiver receiver{};
+    for (auto i = 0; i < 8; ++i) {
+        sig.connect([&receiver](int x) { receiver.onEvent(x); });
+    }
+    for (auto _ : state) {
+        sig(1);
+    }
+}
+BENCHMARK(BM_EmitLambda);
+
+void BM_EmitMemberFunction(benchmark::State& state)
+{
+    Signal<void(int)> sig{};
+    Receiver receiver{};
+    for (auto i = 0; i < 8; ++i) {
+        sig.connect(&receiver, &Receiver::onEvent);
+    }
+    for (auto _ : state) {
+        sig(1);
+    }
+}
+BENCHMARK(BM_EmitMemberFunction);
+
+void BM_EmitMemFn(benchmark::State& state)
+{
+    Signal<void(int)> sig{};
+    Receiver receiver{};
+    for (auto i = 0; i < 8; ++i) {
+        sig.connect(&receiver, std::mem_fn<void(int)>(&Receiver::onEvent));
+    }
+    for (auto _ : state) {
+        sig(1);
+    }
+}
+BENCHMARK(BM_EmitMemFn);
+
+/// The same eight member function slots fixed at compile time, emitting is eight direct calls.
+void BM_EmitStatic(benchmark::State& state)
+{
+    Receiver receiver{};
+    using Slot = StaticSlot<&Receiver::onEvent>;
+    auto sig = makeStaticSignal<void(int)>(
+        Slot{&receiver}, Slot{&receiver}, Slot{&receiver}, Slot{&receiver},
+        Slot{&receiver}, Slot{&receiver}, Slot{&receiver}, Slot{&receiver});
+    for (auto _ : state) {
+        sig(1);
+    }
+}
+BENCHMARK(BM_EmitStatic);
+
+/// Emit cost of a queued connection, the emitter only pays for posting the call.
+void BM_EmitQueued(benchmark::State& state)
+{
+    Signal<void(int)> sig{};
+    EventQueue queue{};
+    sig.connect(&slot, queue);
+    auto pending = 0;
+    for (auto _ : state) {
+        sig(1);
+        if (++pending == 1024) {
+            state.PauseTiming();
+            queue.drain();
+            pending = 0;
+            state.ResumeTiming();
+        }
+    }
+}
+BENCHMARK(BM_EmitQueued);
+
+/// Emit cost of a coalesced connection, emits after the first only merge into the pending call.
+template <typename Policy>
+void BM_EmitCoalesced(benchmark::State& state)
+{
+    Signal<void(int), Policy> sig{};
+    EventQueue queue{};
+    sig.connectCoalesced(&slot, queue);
+    auto pending = 0;
+    for (auto _ : state) {
+        sig(1);
+        if (++pending == 1024) {
+            state.PauseTiming();
+            queue.drain();
+            pending = 0;
+            state.ResumeTiming();
+        }
+    }
+}
+BENCHMARK_TEMPLATE(BM_EmitCoalesced, multi_threaded);
+BENCHMARK_TEMPLATE(BM_EmitCoalesced, single_threaded);
+
+/// Emit range(0) items one at a time, the baseline for emitBatch.
+void BM_EmitLoop(benchmark::State& state)
+{
+    Signal<void(int)> sig{};
+    for (auto i = 0; i < 8; ++i) {
+        sig.connect(&slot);
+    }
+    const auto items = std::vector<Signal<void(int)>::BatchItem>(state.range(0), {1});
+    for (auto _ : state) {
+        for (const auto& item : items) {
+            sig(std::get<0>(item));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EmitLoop)->Arg(1024);
+
+void BM_EmitBatch(benchmark::State& state)
+{
+    Signal<void(int)> sig{};
+    for (auto i = 0; i < 8; ++i) {
+        sig.connect(&slot);
+    }
+    const auto items = std::vector<Signal<void(int)>::BatchItem>(state.range(0), {1});
+    for (auto _ : state) {
+        sig.emitBatch(items);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EmitBatch)->Arg(1024);
+
+void BM_EmitBatchSlot(benchmark::State& state)
+{
+    using Sig = Signal<void(int)>;
+    Sig sig{};
+    for (auto i = 0; i < 8; ++i) {
+        sig.connectBatch([](const Sig::BatchItem* items, std::size_t count) {
+            for (auto I = items; I != items + count; ++I) {
+                slot(std::get<0>(*I));
+            }
+        });
+    }
+    const auto items = std::vector<Sig::BatchItem>(state.range(0), {1});
+    for (auto _ : state) {
+        sig.emitBatch(items);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EmitBatchSlot)->Arg(1024);
+
+/// Emit to range(0) handlers where the first one called handles the emission.
+void BM_EmitHandledFirst(benchmark::State& state)
+{
+    Signal<Handled(int)> sig{};
+    for (auto i = 0; i < state.range(0); ++i) {
+        sig.connect([](int x) {
+            benchmark::DoNotOptimize(x);
+            return Handled::No;
+        });
+    }
+    sig.connect([](int) { return Handled::Yes; });
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sig(1));
+    }
+}
+BENCHMARK(BM_EmitHandledFirst)->Arg(200);
+
+/// Emit one of range(0) keys with a slot each, the baseline for SignalMap.
+void BM_EmitKeyedUnorderedMap(benchmark::State& state)
+{
+    auto signals = std::unordered_map<int, Signal<void(int)>>{};
+    for (auto key = 0; key < state.range(0); ++key) {
+        signals[key].connect(&slot);
+    }
+    auto key = 0;
+    for (auto _ : state) {
+        const auto found = signals.find(key);
+        if (found != signals.end()) {
+            found->second(1);
+        }
+        key = (key + 1) % state.range(0);
+    }
+}
+BENCHMARK(BM_EmitKeyedUnorderedMap)->Arg(16)->Arg(10000);
+
+void BM_EmitKeyedSignalMap(benchmark::State& state)
+{
+    SignalMap<int, void(int)> signals{};
+    for (auto key = 0; key < state.range(0); ++key) {
+        signals.connect(key, &slot);
+    }
+    auto key = 0;
+    for (auto _ : state) {
+        signals(key, 1);
+        key = (key + 1) % state.range(0);
+    }
+}
+BENCHMARK(BM_EmitKeyedSignalMap)->Arg(16)->Arg(10000);
+
+} // namespace moment
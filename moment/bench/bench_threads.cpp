@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+
+#include <moment/Signal.hpp>
+
+namespace {
+
+void slot(int x)
+{
+    benchmark::DoNotOptimize(x);
+}
+
+template <typename Policy>
+moment::Signal<void(int), Policy>& sharedSignal()
+{
+    static moment::Signal<void(int), Policy> sig{};
+    static const auto connected = [] {
+        for (auto i = 0; i < 8; ++i) {
+            sig.connect(&slot);
+        }
+        return true;
+    }();
+    benchmark::DoNotOptimize(connected);
+    return sig;
+}
+
+} // namespace
+
+namespace moment {
+
+/// Several threads emitting the same signal.
+template <typename Policy>
+void BM_EmitContended(benchmark::State& state)
+{
+    auto& sig = sharedSignal<Policy>();
+    for (auto _ : state) {
+        sig(1);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_EmitContended, multi_threaded)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_EmitContended, lock_free)->ThreadRange(1, 16)->UseRealTime();
+
+/// Several threads emitting the same signal while the first thread connects and disconnects, e.g. session listeners.
+template <typename Policy>
+void BM_EmitWhileChurning(benchmark::State& state)
+{
+    auto& sig = sharedSignal<Policy>();
+    if (state.thread_index() == 0) {
+        for (auto _ : state) {
+            auto connection = sig.connect(&slot);
+            connection.disconnect();
+        }
+    } else {
+        for (auto _ : state) {
+            sig(1);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_EmitWhileChurning, multi_threaded)->ThreadRange(2, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_EmitWhileChurning, lock_free)->ThreadRange(2, 16)->UseRealTime();
+
+/// A slot doing enough work that running it on another thread pays off.
+void heavySlot(int x)
+{
+    for (auto i = 0; i < 1000; ++i) {
+        benchmark::DoNotOptimize(x += i);
+    }
+}
+
+/// Emit to 256 heavy slots one after another, the baseline for emitParallel.
+void BM_EmitHeavy(benchmark::State& state)
+{
+    Signal<void(int)> sig{};
+    for (auto i = 0; i < 256; ++i) {
+        sig.connect(&heavySlot);
+    }
+    for (auto _ : state) {
+        sig(1);
+    }
+}
+BENCHMARK(BM_EmitHeavy)->UseRealTime();
+
+/// Emit to 256 heavy slots in chunks of range(0) across a thread pool.
+void BM_EmitParallel(benchmark::State& state)
+{
+    Signal<void(int)> sig{};
+    ThreadPool pool{};
+    for (auto i = 0; i < 256; ++i) {
+        sig.connect(&heavySlot);
+    }
+    for (auto _ : state) {
+        sig.emitParallel(pool, static_cast<std::size_t>(state.range(0)), 1);
+    }
+}
+BENCHMARK(BM_EmitParallel)->Arg(1)->Arg(16)->Arg(64)->UseRealTime();
+
+} // namespace moment
@@ -0,0 +1,373 @@
+#pragma once
+
+#include <moment/Signal.hpp>
+
+#if MOMENT_COROUTINES
+
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace moment {
+
+/// Resumes a suspended coroutine, inline or by posting it to an executor.
+using Resumer = Delegate<void(std::coroutine_handle<>)>;
+
+/// The value co_await produces for an emission: nothing, the argument, or a tuple of the arguments.
+template <typename... Values>
+struct EmissionResult {
+    using Type = std::tuple<Values...>;
+    static Type take(std::tuple<Values...>&& values) { return std::move(values); }
+};
+
+template <>
+struct EmissionResult<> {
+    using Type = void;
+    static void take(std::tuple<>&&) {}
+};
+
+template <typename Value>
+struct EmissionResult<Value> {
+    using Type = Value;
+    static Type take(std::tuple<Value>&& values) { return std::get<0>(std::move(values)); }
+};
+
+/// [[[ SignalAwaiter ---------------------------------------------------------
+
+/// Awaits the next emission of a signal, see Signal::next.
+/// @note Awaiting connects to the signal with connectOnce, whose connection is the only allocation and comes from
+/// the resource of the signal. The slot stores a copy of the arguments in the awaiter and resumes the coroutine.
+/// @note Reference parameters are awaited as copies of the argument.
+/// @note If the signal is destroyed before it is emitted the coroutine is never resumed. Destroying the coroutine
+/// while suspended disconnects, but must not race with an emission.
+template <typename Ret, typename... Params, typename Policy>
+class SignalAwaiter<Ret(Params...), Policy> {
+public:
+    using Values = std::tuple<std::decay_t<Params>...>;
+    using Result = typename EmissionResult<std::decay_t<Params>...>::Type;
+
+    SignalAwaiter(Signal<Ret(Params...), Policy>& signal, Resumer&& resumer);
+    ~SignalAwaiter();
+
+    /// Non-copyable / Non-movable
+    SignalAwaiter(const SignalAwaiter&) = delete;
+    SignalAwaiter(SignalAwaiter&&) = delete;
+    SignalAwaiter& operator=(const SignalAwaiter&) = delete;
+    SignalAwaiter& operator=(SignalAwaiter&&) = delete;
+
+    bool await_ready() const noexcept;
+    /// @returns False if the signal was emitted while connecting, the coroutine then continues right away.
+    bool await_suspend(std::coroutine_handle<> handle);
+    Result await_resume();
+
+private:
+    static_assert(std::is_void<Ret>::value, "Only signals returning void can be awaited");
+
+    enum class State { Connecting, Suspended, Emitted };
+
+    /// Called once by the emission, the coroutine owns the awaiter again once it is resumed.
+    void emitted(ArgRef<Params>... args);
+
+    Signal<Ret(Params...), Policy>& _signal;
+    Resumer _resumer;
+    std::coroutine_handle<> _handle;
+    Connection<Ret(Params...), Policy> _connection;
+    std::optional<Values> _values;
+    /// Decides whether the emission or await_suspend continues the coroutine.
+    typename Policy::template Atomic<State> _state{State::Connecting};
+};
+
+template <typename Ret, typename... Params, typename Policy>
+inline SignalAwaiter<Ret(Params...), Policy>::SignalAwaiter(Signal<Ret(Params...), Policy>& signal,
+                                                            Resumer&& resumer)
+: _signal{signal}
+, _resumer{std::move(resumer)}
+{
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline SignalAwaiter<Ret(Params...), Policy>::~SignalAwaiter()
+{
+    _connection.disconnect();
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline bool SignalAwaiter<Ret(Params...), Policy>::await_ready() const noexcept
+{
+    return false;
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline bool SignalAwaiter<Ret(Params...), Policy>::await_suspend(std::coroutine_handle<> handle)
+{
+    _handle = handle;
+    _connection = _signal.connectOnce([this](ArgRef<Params>... args) { emitted(args...); });
+    return _state.exchange(State::Suspended, std::memory_order_acq_rel) != State::Emitted;
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline auto SignalAwaiter<Ret(Params...), Policy>::await_resume() -> Result
+{
+    return EmissionResult<std::decay_t<Params>...>::take(std::move(*_values));
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline void SignalAwaiter<Ret(Params...), Policy>::emitted(ArgRef<Params>... args)
+{
+    _values.emplace(args...);
+    if (_state.exchange(State::Emitted, std::memory_order_acq_rel) == State::Suspended) {
+        /// Resuming may destroy the awaiter
+        auto handle = _handle;
+        auto resumer = std::move(_resumer);
+        resumer(handle);
+    }
+}
+
+/// ]]] SignalAwaiter ---------------------------------------------------------
+
+/// [[[ SignalStream ----------------------------------------------------------
+
+/// Generic template declaration. SignalStream is a template specialization to allow for SignalStream<void(int)>
+template <typename, typename Policy = multi_threaded>
+class SignalStream;
+
+/// Buffers the emissions of a signal so a coroutine can await them one after the other, e.g.
+///     SignalStream<void(int)> stream{signal, 64};
+///     while (true) { const auto value = co_await stream.next(); }
+/// @note The stream stays connected for its lifetime, so no emission is missed between two awaits. At most capacity
+/// emissions are buffered, when full the oldest is dropped, see dropped(). The buffer is allocated once, an emission
+/// only copies its arguments into it or hands them to the waiting coroutine.
+/// @note Only one coroutine may await the stream at a time. A coroutine still waiting when the stream is destroyed is
+/// never resumed.
+template <typename Ret, typename... Params, typename Policy>
+class SignalStream<Ret(Params...), Policy> {
+    class Awaiter;
+
+public:
+    using Values = std::tuple<std::decay_t<Params>...>;
+    using Result = typename EmissionResult<std::decay_t<Params>...>::Type;
+
+    /// @param capacity The number of emissions buffered, must be at least 1.
+    SignalStream(Signal<Ret(Params...), Policy>& signal, std::size_t capacity);
+    ~SignalStream();
+
+    /// Non-copyable / Non-movable
+    SignalStream(const SignalStream&) = delete;
+    SignalStream(SignalStream&&) = delete;
+    SignalStream& operator=(const SignalStream&) = delete;
+    SignalStream& operator=(SignalStream&&) = delete;
+
+    /// Await the oldest buffered emission, or the next one if none is buffered.
+    /// @note The coroutine is resumed on the emitting thread.
+    Awaiter next();
+
+    /// Await the oldest buffered emission, or the next one if none is buffered.
+    /// @note The coroutine is resumed by posting it to @p executor when it had to wait, see Signal::next.
+    template <typename Executor>
+    Awaiter next(Executor& executor);
+
+    /// @returns The number of emissions buffered.
+    std::size_t size() const;
+
+    /// @returns The number of emissions dropped because the buffer was full.
+    std::size_t dropped() const;
+
+private:
+    static_assert(std::is_void<Ret>::value, "Only signals returning void can be awaited");
+
+    class Awaiter {
+    public:
+        Awaiter(SignalStream& stream, Resumer&& resumer);
+        ~Awaiter();
+
+        /// Non-copyable / Non-movable
+        Awaiter(const Awaiter&) = delete;
+        Awaiter(Awaiter&&) = delete;
+        Awaiter& operator=(const Awaiter&) = delete;
+        Awaiter& operator=(Awaiter&&) = delete;
+
+        bool await_ready();
+        bool await_suspend(std::coroutine_handle<> handle);
+        Result await_resume();
+
+    private:
+        friend class SignalStream;
+
+        SignalStream& _stream;
+        Resumer _resumer;
+        std::coroutine_handle<> _handle;
+        std::optional<Values> _values;
+    };
+
+    using Lock = std::unique_lock<typename Policy::Mutex>;
+
+    void push(ArgRef<Params>... args);
+    /// Move the oldest emission into @p values, the buffer must not be empty.
+    void pop(std::optional<Values>& values);
+
+    mutable typename Policy::Mutex _mutex;
+    /// A ring of _size emissions starting at _head, guarded by _mutex.
+    std::vector<std::optional<Values>> _buffer;
+    std::size_t _head{0u};
+    std::size_t _size{0u};
+    std::size_t _dropped{0u};
+    /// The coroutine waiting for an emission, guarded by _mutex.
+    Awaiter* _waiter{nullptr};
+    Connection<Ret(Params...), Policy> _connection;
+};
+
+template <typename Ret, typename... Params, typename Policy>
+inline SignalStream<Ret(Params...), Policy>::SignalStream(Signal<Ret(Params...), Policy>& signal,
+                                                          std::size_t capacity)
+: _buffer(capacity)
+{
+    assert(capacity > 0u);
+    _connection = signal.connect([this](ArgRef<Params>... args) { push(args...); });
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline SignalStream<Ret(Params...), Policy>::~SignalStream()
+{
+    _connection.disconnect();
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline auto SignalStream<Ret(Params...), Policy>::next() -> Awaiter
+{
+    return Awaiter{*this, [](std::coroutine_handle<> handle) { handle.resume(); }};
+}
+
+template <typename Ret, typename... Params, typename Policy>
+template <typename Executor>
+inline auto SignalStream<Ret(Params...), Policy>::next(Executor& executor) -> Awaiter
+{
+    return Awaiter{*this, [&executor](std::coroutine_handle<> handle) {
+                       executor.post([handle]() { handle.resume(); });
+                   }};
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline std::size_t SignalStream<Ret(Params...), Policy>::size() const
+{
+    Lock lock{_mutex};
+    return _size;
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline std::size_t SignalStream<Ret(Params...), Policy>::dropped() const
+{
+    Lock lock{_mutex};
+    return _dropped;
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline void SignalStream<Ret(Params...), Policy>::push(ArgRef<Params>... args)
+{
+    Lock lock{_mutex};
+    if (const auto waiter = std::exchange(_waiter, nullptr)) {
+        waiter->_values.emplace(args...);
+        lock.unlock();
+        /// Resuming may destroy the awaiter
+        auto handle = waiter->_handle;
+        auto resumer = std::move(waiter->_resumer);
+        resumer(handle);
+        return;
+    }
+    if (_size == _buffer.size()) {
+        _buffer[_head].reset();
+        _head = (_head + 1u) % _buffer.size();
+        --_size;
+        ++_dropped;
+    }
+    _buffer[(_head + _size) % _buffer.size()].emplace(args...);
+    ++_size;
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline void SignalStream<Ret(Params...), Policy>::pop(std::optional<Values>& values)
+{
+    auto& oldest = _buffer[_head];
+    values.emplace(std::move(*oldest));
+    oldest.reset();
+    _head = (_head + 1u) % _buffer.size();
+    --_size;
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline SignalStream<Ret(Params...), Policy>::Awaiter::Awaiter(SignalStream& stream, Resumer&& resumer)
+: _stream{stream}
+, _resumer{std::move(resumer)}
+{
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline SignalStream<Ret(Params...), Policy>::Awaiter::~Awaiter()
+{
+    Lock lock{_stream._mutex};
+    if (_stream._waiter == this) {
+        _stream._waiter = nullptr;
+    }
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline bool SignalStream<Ret(Params...), Policy>::Awaiter::await_ready()
+{
+    Lock lock{_stream._mutex};
+    if (_stream._size == 0u) {
+        return false;
+    }
+    _stream.pop(_values);
+    return true;
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline bool SignalStream<Ret(Params...), Policy>::Awaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    Lock lock{_stream._mutex};
+    /// Emitted since await_ready
+    if (_stream._size > 0u) {
+        _stream.pop(_values);
+        return false;
+    }
+    assert(!_stream._waiter && "Only one coroutine may await a stream at a time");
+    _handle = handle;
+    _stream._waiter = this;
+    return true;
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline auto SignalStream<Ret(Params...), Policy>::Awaiter::await_resume() -> Result
+{
+    return EmissionResult<std::decay_t<Params>...>::take(std::move(*_values));
+}
+
+/// ]]] SignalStream ----------------------------------------------------------
+
+/// [[[ Signal::next ----------------------------------------------------------
+
+template <typename Ret, typename... Params, typename Policy>
+inline SignalAwaiter<Ret(Params...), Policy> Signal<Ret(Params...), Policy>::next()
+{
+    return SignalAwaiter<Ret(Params...), Policy>{*this, [](std::coroutine_handle<> handle) { handle.resume(); }};
+}
+
+template <typename Ret, typename... Params, typename Policy>
+template <typename Executor>
+inline SignalAwaiter<Ret(Params...), Policy> Signal<Ret(Params...), Policy>::next(Executor& executor)
+{
+    return SignalAwaiter<Ret(Params...), Policy>{*this, [&executor](std::coroutine_handle<> handle) {
+                                                     executor.post([handle]() { handle.resume(); });
+                                                 }};
+}
+
+/// ]]] Signal::next ----------------------------------------------------------
+
+} // namespace moment
+
+#endif
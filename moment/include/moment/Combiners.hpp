@@ -0,0 +1,136 @@
+#pragma once
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+/// Combiners aggregate the values returned by the slots of a signal, see Signal::emitCombined. A combiner provides:
+///   bool operator()(T value) - Take the value returned by a slot, return false to stop calling further slots.
+///   result()                 - Get the combined result once emission is done.
+
+namespace moment {
+
+/// Returned by the slots of a Signal<Handled(...)> to end emission, see until_handled.
+enum class Handled : bool {
+    No = false,
+    Yes = true,
+};
+
+/// [[[ Combiners -------------------------------------------------------------
+
+/// The value returned by the last slot called, empty if no slot was called.
+template <typename T>
+class last {
+public:
+    bool operator()(T value)
+    {
+        _value = std::move(value);
+        return true;
+    }
+
+    std::optional<T> result() { return std::move(_value); }
+
+private:
+    std::optional<T> _value;
+};
+
+/// True if every slot returned true, stops at the first slot returning false.
+class logical_and {
+public:
+    bool operator()(bool value)
+    {
+        _value = value;
+        return _value;
+    }
+
+    bool result() const { return _value; }
+
+private:
+    bool _value{true};
+};
+
+/// True if any slot returned true, stops at the first slot returning true.
+class logical_or {
+public:
+    bool operator()(bool value)
+    {
+        _value = value;
+        return !_value;
+    }
+
+    bool result() const { return _value; }
+
+private:
+    bool _value{false};
+};
+
+/// The sum of the values returned by the slots, T{} if no slot was called.
+template <typename T>
+class sum {
+public:
+    bool operator()(T value)
+    {
+        _value += std::move(value);
+        return true;
+    }
+
+    T result() { return std::move(_value); }
+
+private:
+    T _value{};
+};
+
+/// The values returned by the slots in the order the slots were called.
+template <typename T, typename Container = std::vector<T>>
+class collect {
+public:
+    bool operator()(T value)
+    {
+        _values.push_back(std::move(value));
+        return true;
+    }
+
+    Container result() { return std::move(_values); }
+
+private:
+    Container _values;
+};
+
+/// The first value returned that converts to true, e.g. a non null pointer, stops at that slot. T{} if there is none.
+template <typename T>
+class first_non_null {
+public:
+    bool operator()(T value)
+    {
+        if (!value) {
+            return true;
+        }
+        _value = std::move(value);
+        return false;
+    }
+
+    T result() { return std::move(_value); }
+
+private:
+    T _value{};
+};
+
+/// Handled::Yes if any slot handled the emission, stops at the first slot returning Handled::Yes.
+/// @note Used by emit for signals returning Handled.
+class until_handled {
+public:
+    bool operator()(Handled value)
+    {
+        _value = value;
+        return _value == Handled::No;
+    }
+
+    Handled result() const { return _value; }
+
+private:
+    Handled _value{Handled::No};
+};
+
+/// ]]] Combiners -------------------------------------------------------------
+
+} // namespace moment
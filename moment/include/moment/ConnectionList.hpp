@@ -0,0 +1,382 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+#include <moment/EmitScope.hpp>
+#include <moment/MemoryResource.hpp>
+
+namespace moment {
+
+/// [[[ ConnectionList --------------------------------------------------------
+
+/// A fixed capacity, append only list of connections shared between a signal and its emitters.
+/// @note Published elements are never modified, so an emitter can iterate the first size() elements while the signal
+/// appends behind it. CopyOnWriteConnections replaces the whole list when it needs to grow or to drop dead
+/// connections.
+template <typename T, typename Policy>
+class ConnectionList {
+public:
+    /// @param resource The resource the elements are allocated from.
+    ConnectionList(std::pmr::memory_resource* resource, std::size_t capacity);
+    ~ConnectionList();
+
+    /// Non-copyable / Non-movable
+    ConnectionList(const ConnectionList&) = delete;
+    ConnectionList(ConnectionList&&) = delete;
+    ConnectionList& operator=(const ConnectionList&) = delete;
+    ConnectionList& operator=(ConnectionList&&) = delete;
+
+    /// Get the number of published elements.
+    std::size_t size() const;
+
+    /// Get the number of elements that fit in the list.
+    std::size_t capacity() const;
+
+    /// Get the published elements.
+    const T* data() const;
+
+    /// Append and publish an element.
+    /// @note Appends must be serialized and the list must not be full.
+    void push_back(T value);
+
+private:
+    std::pmr::memory_resource* const _resource;
+    const std::size_t _capacity;
+    T* const _data;
+    typename Policy::template Atomic<std::size_t> _size{0u};
+};
+
+template <typename T, typename Policy>
+inline ConnectionList<T, Policy>::ConnectionList(std::pmr::memory_resource* resource, std::size_t capacity)
+: _resource{resource}
+, _capacity{capacity}
+, _data{newArray<T>(resource, capacity)}
+{
+}
+
+template <typename T, typename Policy>
+inline ConnectionList<T, Policy>::~ConnectionList()
+{
+    deleteArray(_resource, _data, _capacity);
+}
+
+template <typename T, typename Policy>
+inline std::size_t ConnectionList<T, Policy>::size() const
+{
+    return _size.load(std::memory_order_acquire);
+}
+
+template <typename T, typename Policy>
+inline std::size_t ConnectionList<T, Policy>::capacity() const
+{
+    return _capacity;
+}
+
+template <typename T, typename Policy>
+inline const T* ConnectionList<T, Policy>::data() const
+{
+    return _data;
+}
+
+template <typename T, typename Policy>
+inline void ConnectionList<T, Policy>::push_back(T value)
+{
+    const auto size = _size.load(std::memory_order_relaxed);
+    assert(size < _capacity);
+    _data[size] = std::move(value);
+    _size.store(size + 1u, std::memory_order_release);
+}
+
+/// ]]] ConnectionList --------------------------------------------------------
+
+/// [[[ CopyOnWriteConnections ------------------------------------------------
+
+/// The connections of a signal, stored in a ConnectionList that emitters read through an immutable snapshot.
+/// @note Emitting never takes the lock, connect and disconnect are serialized by Policy::Mutex. Connect appends to the
+/// list in place and only copies it when it is full, so it is O(1) amortized.
+/// @note Disconnecting only marks the connection as dead, dead connections are skipped when emitting and dropped once
+/// they make up more than half of the list, so disconnect is O(1) amortized. When a slot disconnects, dropping them
+/// is deferred until the outermost emission of these connections on its thread ends, so emitting never copies the
+/// list.
+/// @note The list is kept sorted by priority, see connect.
+/// @note The lists are allocated from a memory resource, which must be thread safe if the connections are.
+/// @tparam T A pointer to a connection, which provides valid(), invalidate() and priority().
+/// @tparam Policy The threading policy, see ThreadingPolicy.hpp.
+template <typename T, typename Policy>
+class CopyOnWriteConnections {
+    using List = ConnectionList<T, Policy>;
+    using Snapshot = typename Policy::template SharedPtr<List>;
+
+public:
+    /// Connections are kept in priority order.
+    static constexpr bool prioritized = true;
+    /// Views expose the connections as an array.
+    static constexpr bool contiguous = true;
+
+    /// The connections at the time the view was taken.
+    /// @note Drops dead connections once destroyed if a slot deferred it.
+    class View {
+    public:
+        View(CopyOnWriteConnections& connections, Snapshot list);
+        ~View();
+
+        /// Non-copyable / Non-movable
+        View(const View&) = delete;
+        View(View&&) = delete;
+        View& operator=(const View&) = delete;
+        View& operator=(View&&) = delete;
+
+        /// Calls @p func with each connection, in the order slots are called in.
+        /// @note If @p func returns a bool, stops at the first connection it returns false for.
+        template <typename Func>
+        void forEach(Func&& func) const;
+
+        /// Get the number of connections, including dead ones.
+        std::size_t size() const;
+
+        /// Get the connections, the last is called first.
+        const T* data() const;
+
+    private:
+        CopyOnWriteConnections& _connections;
+        Snapshot _list;
+        EmitScope _scope;
+    };
+
+    /// @param resource The resource lists are allocated from, must outlive the connections.
+    explicit CopyOnWriteConnections(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    /// Non-copyable / Non-movable
+    CopyOnWriteConnections(const CopyOnWriteConnections&) = delete;
+    CopyOnWriteConnections(CopyOnWriteConnections&&) = delete;
+    CopyOnWriteConnections& operator=(const CopyOnWriteConnections&) = delete;
+    CopyOnWriteConnections& operator=(CopyOnWriteConnections&&) = delete;
+
+    /// Get the current connections.
+    View view();
+
+    /// Add a connection.
+    /// @note Connections with a higher priority are called first, newer connections first within a priority.
+    /// Connecting at the highest priority so far is O(1) amortized, any lower priority copies the list.
+    void connect(T connection);
+
+    /// Invalidate and remove a connection.
+    /// @param connection Points to the connection, it need not own it.
+    /// @returns True if the connection was valid, false otherwise.
+    template <typename Ptr>
+    bool disconnect(const Ptr& connection);
+
+    /// Invalidate and remove all connections.
+    void clear();
+
+    /// Get the resource lists are allocated from.
+    std::pmr::memory_resource* resource() const;
+
+private:
+    using StateLock = std::lock_guard<typename Policy::Mutex>;
+
+    /// Invalidate and remove all connections under a lock.
+    void clearLocked(const StateLock&);
+    /// Drop dead connections if a disconnect deferred it and they still make up more than half of the list.
+    void compactDeferred();
+    /// Copy the connections that are still valid under a lock.
+    /// @param insert A connection to insert in priority order into the copy, may be null.
+    /// @returns The copy, null if it would be empty.
+    Snapshot copyValidLocked(const StateLock&, const T& insert);
+    /// @returns An immutable snapshot of the connections, may be null if there are none.
+    Snapshot snapshot() const;
+    /// Replace the current connections under a lock.
+    void publishLocked(const StateLock&, Snapshot list);
+
+    std::pmr::memory_resource* const _resource;
+    /// Serializes connect and disconnect, never held while emitting.
+    mutable typename Policy::Mutex _stateMutex;
+    /// Only accessed through Policy::load / Policy::store.
+    Snapshot _list;
+    /// Number of disconnected connections still in _list, guarded by _stateMutex.
+    std::size_t _deadCount{0u};
+    /// Set when a slot disconnected enough connections to drop them, read by emitters without the lock.
+    typename Policy::template Atomic<bool> _compactDeferred{false};
+};
+
+template <typename T, typename Policy>
+inline CopyOnWriteConnections<T, Policy>::CopyOnWriteConnections(std::pmr::memory_resource* resource)
+: _resource{resource}
+{
+}
+
+template <typename T, typename Policy>
+inline CopyOnWriteConnections<T, Policy>::View::View(CopyOnWriteConnections& connections, Snapshot list)
+: _connections{connections}
+, _list{std::move(list)}
+, _scope{&connections}
+{
+}
+
+template <typename T, typename Policy>
+inline CopyOnWriteConnections<T, Policy>::View::~View()
+{
+    if (_connections._compactDeferred.load(std::memory_order_relaxed) && _scope.outermost()) {
+        _connections.compactDeferred();
+    }
+}
+
+template <typename T, typename Policy>
+template <typename Func>
+inline void CopyOnWriteConnections<T, Policy>::View::forEach(Func&& func) const
+{
+    const auto first = data();
+    for (auto I = first + size(); I != first;) {
+        if constexpr (std::is_same<decltype(func(**I)), bool>::value) {
+            if (!func(**--I)) {
+                return;
+            }
+        } else {
+            func(**--I);
+        }
+    }
+}
+
+template <typename T, typename Policy>
+inline std::size_t CopyOnWriteConnections<T, Policy>::View::size() const
+{
+    return _list ? _list->size() : 0u;
+}
+
+template <typename T, typename Policy>
+inline const T* CopyOnWriteConnections<T, Policy>::View::data() const
+{
+    return _list ? _list->data() : nullptr;
+}
+
+template <typename T, typename Policy>
+inline auto CopyOnWriteConnections<T, Policy>::view() -> View
+{
+    return View{*this, snapshot()};
+}
+
+template <typename T, typename Policy>
+inline void CopyOnWriteConnections<T, Policy>::connect(T connection)
+{
+    StateLock lock{_stateMutex};
+    const auto list = snapshot();
+    const auto size = list ? list->size() : 0u;
+    const auto append =
+        size != 0u && size < list->capacity() && list->data()[size - 1u]->priority() <= connection->priority();
+    if (append) {
+        list->push_back(std::move(connection));
+    } else {
+        publishLocked(lock, copyValidLocked(lock, connection));
+    }
+}
+
+template <typename T, typename Policy>
+template <typename Ptr>
+inline bool CopyOnWriteConnections<T, Policy>::disconnect(const Ptr& connection)
+{
+    StateLock lock{_stateMutex};
+    if (!connection->invalidate()) {
+        return false;
+    }
+    const auto list = snapshot();
+    if (2u * ++_deadCount > list->size()) {
+        if (EmitScope::active(this)) {
+            _compactDeferred.store(true, std::memory_order_relaxed);
+        } else {
+            publishLocked(lock, copyValidLocked(lock, nullptr));
+        }
+    }
+    return true;
+}
+
+template <typename T, typename Policy>
+inline void CopyOnWriteConnections<T, Policy>::clear()
+{
+    StateLock lock{_stateMutex};
+    clearLocked(lock);
+}
+
+template <typename T, typename Policy>
+inline std::pmr::memory_resource* CopyOnWriteConnections<T, Policy>::resource() const
+{
+    return _resource;
+}
+
+template <typename T, typename Policy>
+inline void CopyOnWriteConnections<T, Policy>::clearLocked(const StateLock& lock)
+{
+    if (const auto list = snapshot()) {
+        for (auto I = 0u; I < list->size(); ++I) {
+            list->data()[I]->invalidate();
+        }
+    }
+    _deadCount = 0u;
+    _compactDeferred.store(false, std::memory_order_relaxed);
+    publishLocked(lock, nullptr);
+}
+
+template <typename T, typename Policy>
+inline void CopyOnWriteConnections<T, Policy>::compactDeferred()
+{
+    StateLock lock{_stateMutex};
+    if (!_compactDeferred.load(std::memory_order_relaxed)) {
+        return;
+    }
+    const auto list = snapshot();
+    if (list && 2u * _deadCount > list->size()) {
+        publishLocked(lock, copyValidLocked(lock, nullptr));
+    } else {
+        _compactDeferred.store(false, std::memory_order_relaxed);
+    }
+}
+
+template <typename T, typename Policy>
+inline auto CopyOnWriteConnections<T, Policy>::copyValidLocked(const StateLock&, const T& insert) -> Snapshot
+{
+    const auto current = snapshot();
+    const auto count = current ? current->size() : 0u;
+    const auto size = count - _deadCount + (insert ? 1u : 0u);
+    _deadCount = 0u;
+    _compactDeferred.store(false, std::memory_order_relaxed);
+    if (size == 0u) {
+        return nullptr;
+    }
+    /// Leave room to double before the next copy
+    auto list = Policy::template makeShared<List>(_resource, _resource, 2u * size);
+    auto inserted = !insert;
+    for (auto I = 0u; I < count; ++I) {
+        const auto& connection = current->data()[I];
+        if (!inserted && connection->priority() > insert->priority()) {
+            list->push_back(insert);
+            inserted = true;
+        }
+        if (connection->valid()) {
+            list->push_back(connection);
+        }
+    }
+    if (!inserted) {
+        list->push_back(insert);
+    }
+    return list;
+}
+
+template <typename T, typename Policy>
+inline auto CopyOnWriteConnections<T, Policy>::snapshot() const -> Snapshot
+{
+    return Policy::load(_list);
+}
+
+template <typename T, typename Policy>
+inline void CopyOnWriteConnections<T, Policy>::publishLocked(const StateLock&, Snapshot list)
+{
+    Policy::store(_list, std::move(list));
+}
+
+/// ]]] CopyOnWriteConnections ------------------------------------------------
+
+} // namespace moment
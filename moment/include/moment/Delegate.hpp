@@ -0,0 +1,350 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <moment/MemoryResource.hpp>
+
+namespace moment {
+
+/// The type an argument of type @p T is passed through a delegate as.
+/// @note Values are passed by const reference so that calling several delegates with the same arguments never copies
+/// them, references are passed as is.
+template <typename T>
+using ArgRef = std::conditional_t<std::is_reference<T>::value, T, const T&>;
+
+/// Generic template declaration. Delegate is a template specialization to allow for Delegate<void(int, int)>
+/// @tparam InlineSize The size in bytes of the buffer callables are stored in without allocating.
+template <typename, std::size_t InlineSize = 48>
+class Delegate;
+
+/// [[[ Delegate --------------------------------------------------------------
+
+/// A move only callable wrapper that stores small callables inline rather than on the heap.
+/// @note Callables that are larger than the inline buffer, over aligned or not nothrow movable are allocated from a
+/// memory resource, std::pmr::get_default_resource() unless one is given.
+/// @note Object + member function pointer pairs always fit inline.
+template <typename Ret, typename... Params, std::size_t InlineSize>
+class Delegate<Ret(Params...), InlineSize> {
+public:
+    Delegate() = default;
+    ~Delegate();
+
+    /// Construct a delegate from a callable.
+    /// @param func The callable to store.
+    template <typename Func,
+              typename = std::enable_if_t<!std::is_same<std::decay_t<Func>, Delegate>::value &&
+                                          std::is_invocable_r<Ret, std::decay_t<Func>&, ArgRef<Params>...>::value>>
+    Delegate(Func&& func);
+
+    /// Construct a delegate from a callable, allocating it from @p resource if it does not fit inline.
+    /// @param resource The resource to allocate from, must outlive the delegate.
+    /// @param func The callable to store.
+    template <typename Func,
+              typename = std::enable_if_t<!std::is_same<std::decay_t<Func>, Delegate>::value &&
+                                          std::is_invocable_r<Ret, std::decay_t<Func>&, ArgRef<Params>...>::value>>
+    Delegate(std::allocator_arg_t, std::pmr::memory_resource* resource, Func&& func);
+
+    /// Construct a delegate calling a member function on an object.
+    /// @tparam Obj The object type.
+    /// @tparam MemFunc The member fuction type.
+    /// @param object The object to call the member function on.
+    /// @param memFunc The member function to call.
+    template <typename Obj, typename MemFunc>
+    Delegate(Obj* object, MemFunc Obj::*memFunc);
+
+    /// Movable
+    Delegate(Delegate&& other) noexcept;
+    Delegate& operator=(Delegate&& other) noexcept;
+
+    /// Non-copyable
+    Delegate(const Delegate&) = delete;
+    Delegate& operator=(const Delegate&) = delete;
+
+    /// Call the stored callable.
+    /// @note The delegate must not be empty.
+    Ret operator()(ArgRef<Params>... args) const;
+
+    /// Call the stored callable, moving the arguments into it.
+    /// @note The delegate must not be empty.
+    Ret callMove(Params&&... args) const;
+
+    /// Check if a callable is stored.
+    explicit operator bool() const;
+
+    /// Get the stored callable.
+    /// @tparam Func The type of the callable.
+    /// @returns The callable, null if the delegate is empty or stores a different type.
+    template <typename Func>
+    Func* target() const;
+
+private:
+    using Invoker = Ret (*)(void* storage, ArgRef<Params>... args);
+
+    /// Type erased operations that are not on the common call path.
+    struct Operations {
+        Ret (*invokeMove)(void* storage, Params&&... args);
+        /// Move construct the callable in @p src into @p dst, then destroy @p src.
+        /// @note Null for trivial callables, which are relocated by copying the storage.
+        void (*relocate)(void* dst, void* src) noexcept;
+        /// @note Null for trivial callables.
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    /// Binds an object to a member function.
+    template <typename Obj, typename MemFunc>
+    struct MemberCall {
+        template <typename... Args>
+        decltype(auto) operator()(Args&&... args) const
+        {
+            return (object->*memFunc)(std::forward<Args>(args)...);
+        }
+
+        Obj* object;
+        MemFunc Obj::*memFunc;
+    };
+
+    /// A callable that does not fit inline, along with the resource it was allocated from.
+    template <typename Func>
+    struct HeapCallable {
+        template <typename Arg>
+        HeapCallable(std::pmr::memory_resource* resource, Arg&& func)
+        : resource{resource}
+        , func(std::forward<Arg>(func))
+        {
+        }
+
+        std::pmr::memory_resource* const resource;
+        Func func;
+    };
+
+    template <typename Func>
+    static constexpr bool storedInline = sizeof(Func) <= InlineSize &&
+                                         alignof(std::max_align_t) % alignof(Func) == 0 &&
+                                         std::is_nothrow_move_constructible<Func>::value;
+    template <typename Func>
+    static constexpr bool trivial = std::is_trivially_copyable<Func>::value &&
+                                    std::is_trivially_destructible<Func>::value;
+
+    /// Store @p func inline or in memory from @p resource.
+    template <typename Func, typename Arg>
+    void store(std::pmr::memory_resource* resource, Arg&& func);
+
+    template <typename Func>
+    static Func& inlineTarget(void* storage);
+    template <typename Func>
+    static Func& heapTarget(void* storage);
+    template <typename Func, Func& (*Target)(void*)>
+    static Ret invoke(void* storage, ArgRef<Params>... args);
+    template <typename Func, Func& (*Target)(void*)>
+    static Ret invokeMove(void* storage, Params&&... args);
+
+    template <typename Func>
+    static const Operations inlineOperations;
+    template <typename Func>
+    static const Operations heapOperations;
+
+    /// Take over the callable stored in @p other, leaving it empty.
+    void moveFrom(Delegate& other) noexcept;
+    /// Destroy the stored callable.
+    void reset();
+
+    Invoker _invoke{nullptr};
+    const Operations* _operations{nullptr};
+    alignas(std::max_align_t) mutable unsigned char _storage[InlineSize];
+
+    static_assert(InlineSize >= sizeof(void*), "The inline buffer must be able to hold a pointer");
+};
+
+template <typename Ret, typename... Params, std::size_t InlineSize>
+inline Delegate<Ret(Params...), InlineSize>::~Delegate()
+{
+    reset();
+}
+
+template <typename Ret, typename... Params, std::size_t InlineSize>
+template <typename Func, typename>
+inline Delegate<Ret(Params...), InlineSize>::Delegate(Func&& func)
+{
+    store<std::decay_t<Func>>(std::pmr::get_default_resource(), std::forward<Func>(func));
+}
+
+template <typename Ret, typename... Params, std::size_t InlineSize>
+template <typename Func, typename>
+inline Delegate<Ret(Params...), InlineSize>::Delegate(std::allocator_arg_t,
+                                                      std::pmr::memory_resource* resource,
+                                                      Func&& func)
+{
+    store<std::decay_t<Func>>(resource, std::forward<Func>(func));
+}
+
+template <typename Ret, typename... Params, std::size_t InlineSize>
+template <typename Obj, typename MemFunc>
+inline Delegate<Ret(Params...), InlineSize>::Delegate(Obj* object, MemFunc Obj::*memFunc)
+{
+    using Call = MemberCall<Obj, MemFunc>;
+    static_assert(storedInline<Call>, "Member function delegates must not allocate");
+    store<Call>(nullptr, Call{object, memFunc});
+}
+
+template <typename Ret, typename... Params, std::size_t InlineSize>
+inline Delegate<Ret(Params...), InlineSize>::Delegate(Delegate&& other) noexcept
+{
+    moveFrom(other);
+}
+
+template <typename Ret, typename... Params, std::size_t InlineSize>
+inline auto Delegate<Ret(Params...), InlineSize>::operator=(Delegate&& other) noexcept -> Delegate&
+{
+    if (this != &other) {
+        reset();
+        moveFrom(other);
+    }
+    return *this;
+}
+
+template <typename Ret, typename... Params, std::size_t InlineSize>
+inline Ret Delegate<Ret(Params...), InlineSize>::operator()(ArgRef<Params>... args) const
+{
+    assert(_invoke);
+    return _invoke(_storage, std::forward<ArgRef<Params>>(args)...);
+}
+
+template <typename Ret, typename... Params, std::size_t InlineSize>
+inline Ret Delegate<Ret(Params...), InlineSize>::callMove(Params&&... args) const
+{
+    assert(_invoke);
+    return _operations->invokeMove(_storage, std::forward<Params>(args)...);
+}
+
+template <typename Ret, typename... Params, std::size_t InlineSize>
+inline Delegate<Ret(Params...), InlineSize>::operator bool() const
+{
+    return _invoke != nullptr;
+}
+
+template <typename Ret, typename... Params, std::size_t InlineSize>
+template <typename Func>
+inline Func* Delegate<Ret(Params...), InlineSize>::target() const
+{
+    /// Every stored type has its own operations table
+    if constexpr (storedInline<Func>) {
+        return _operations == &inlineOperations<Func> ? &inlineTarget<Func>(_storage) : nullptr;
+    } else {
+        return _operations == &heapOperations<Func> ? &heapTarget<Func>(_storage) : nullptr;
+    }
+}
+
+template <typename Ret, typename... Params, std::size_t InlineSize>
+template <typename Func, typename Arg>
+inline void Delegate<Ret(Params...), InlineSize>::store(std::pmr::memory_resource* resource, Arg&& func)
+{
+    if constexpr (storedInline<Func>) {
+        new (_storage) Func(std::forward<Arg>(func));
+        _invoke = &invoke<Func, &inlineTarget<Func>>;
+        _operations = &inlineOperations<Func>;
+    } else {
+        using Callable = HeapCallable<Func>;
+        new (_storage) Callable*(newObject<Callable>(resource, resource, std::forward<Arg>(func)));
+        _invoke = &invoke<Func, &heapTarget<Func>>;
+        _operations = &heapOperations<Func>;
+    }
+}
+
+template <typename Ret, typename... Params, std::size_t InlineSize>
+template <typename Func>
+inline Func& Delegate<Ret(Params...), InlineSize>::inlineTarget(void* storage)
+{
+    return *static_cast<Func*>(storage);
+}
+
+template <typename Ret, typename... Params, std::size_t InlineSize>
+template <typename Func>
+inline Func& Delegate<Ret(Params...), InlineSize>::heapTarget(void* storage)
+{
+    return (*static_cast<HeapCallable<Func>**>(storage))->func;
+}
+
+template <typename Ret, typename... Params, std::size_t InlineSize>
+template <typename Func, Func& (*Target)(void*)>
+inline Ret Delegate<Ret(Params...), InlineSize>::invoke(void* storage, ArgRef<Params>... args)
+{
+    if constexpr (std::is_void<Ret>::value) {
+        Target(storage)(std::forward<ArgRef<Params>>(args)...);
+    } else {
+        return Target(storage)(std::forward<ArgRef<Params>>(args)...);
+    }
+}
+
+template <typename Ret, typename... Params, std::size_t InlineSize>
+template <typename Func, Func& (*Target)(void*)>
+inline Ret Delegate<Ret(Params...), InlineSize>::invokeMove(void* storage, Params&&... args)
+{
+    if constexpr (!std::is_invocable<Func&, Params&&...>::value) {
+        return invoke<Func, Target>(storage, args...);
+    } else if constexpr (std::is_void<Ret>::value) {
+        Target(storage)(std::forward<Params>(args)...);
+    } else {
+        return Target(storage)(std::forward<Params>(args)...);
+    }
+}
+
+template <typename Ret, typename... Params, std::size_t InlineSize>
+template <typename Func>
+const typename Delegate<Ret(Params...), InlineSize>::Operations
+    Delegate<Ret(Params...), InlineSize>::inlineOperations{
+        &invokeMove<Func, &inlineTarget<Func>>,
+        trivial<Func> ? nullptr
+                      : +[](void* dst, void* src) noexcept {
+                            new (dst) Func(std::move(*static_cast<Func*>(src)));
+                            static_cast<Func*>(src)->~Func();
+                        },
+        trivial<Func> ? nullptr : +[](void* storage) noexcept { static_cast<Func*>(storage)->~Func(); }};
+
+template <typename Ret, typename... Params, std::size_t InlineSize>
+template <typename Func>
+const typename Delegate<Ret(Params...), InlineSize>::Operations
+    Delegate<Ret(Params...), InlineSize>::heapOperations{
+        &invokeMove<Func, &heapTarget<Func>>,
+        [](void* dst, void* src) noexcept { new (dst) HeapCallable<Func>*(*static_cast<HeapCallable<Func>**>(src)); },
+        [](void* storage) noexcept {
+            const auto callable = *static_cast<HeapCallable<Func>**>(storage);
+            deleteObject(callable->resource, callable);
+        }};
+
+template <typename Ret, typename... Params, std::size_t InlineSize>
+inline void Delegate<Ret(Params...), InlineSize>::moveFrom(Delegate& other) noexcept
+{
+    if (!other._invoke) {
+        return;
+    }
+    if (other._operations->relocate) {
+        other._operations->relocate(_storage, other._storage);
+    } else {
+        std::memcpy(_storage, other._storage, InlineSize);
+    }
+    _invoke = other._invoke;
+    _operations = other._operations;
+    other._invoke = nullptr;
+    other._operations = nullptr;
+}
+
+template <typename Ret, typename... Params, std::size_t InlineSize>
+inline void Delegate<Ret(Params...), InlineSize>::reset()
+{
+    if (_operations && _operations->destroy) {
+        _operations->destroy(_storage);
+    }
+    _invoke = nullptr;
+    _operations = nullptr;
+}
+
+/// ]]] Delegate --------------------------------------------------------------
+
+} // namespace moment
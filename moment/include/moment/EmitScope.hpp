@@ -0,0 +1,77 @@
+#pragma once
+
+namespace moment {
+
+/// [[[ EmitScope -------------------------------------------------------------
+
+/// Marks the calling thread as emitting the connections of @p owner for its lifetime, so connection stores can tell a
+/// disconnect made by one of their slots from one made outside of their emissions.
+/// @note Emissions nest when a slot emits. The scopes of a thread are kept innermost first, so each store sees only
+/// its own nesting and a store that is only emitted from other slots still ends its outermost emission.
+class EmitScope {
+public:
+    /// @param owner The connection store being emitted.
+    explicit EmitScope(const void* owner);
+    ~EmitScope();
+
+    /// Non-copyable / Non-movable
+    EmitScope(const EmitScope&) = delete;
+    EmitScope(EmitScope&&) = delete;
+    EmitScope& operator=(const EmitScope&) = delete;
+    EmitScope& operator=(EmitScope&&) = delete;
+
+    /// @returns True if no other emission of the same owner is running on the calling thread.
+    bool outermost() const;
+
+    /// @returns True if the calling thread is emitting the connections of @p owner.
+    static bool active(const void* owner);
+
+private:
+    static EmitScope*& innermost();
+
+    const void* const _owner;
+    /// The scope this one is nested in, if any.
+    EmitScope* const _outer;
+};
+
+inline EmitScope::EmitScope(const void* owner)
+: _owner{owner}
+, _outer{innermost()}
+{
+    innermost() = this;
+}
+
+inline EmitScope::~EmitScope()
+{
+    innermost() = _outer;
+}
+
+inline bool EmitScope::outermost() const
+{
+    for (auto scope = _outer; scope; scope = scope->_outer) {
+        if (scope->_owner == _owner) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline bool EmitScope::active(const void* owner)
+{
+    for (auto scope = innermost(); scope; scope = scope->_outer) {
+        if (scope->_owner == owner) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline EmitScope*& EmitScope::innermost()
+{
+    static thread_local EmitScope* innermost{nullptr};
+    return innermost;
+}
+
+/// ]]] EmitScope -------------------------------------------------------------
+
+} // namespace moment
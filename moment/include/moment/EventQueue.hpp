@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+#include <moment/Delegate.hpp>
+
+namespace moment {
+
+/// A unit of work posted to an executor.
+using Task = Delegate<void()>;
+
+/// [[[ EventQueue ------------------------------------------------------------
+
+/// A lock free multiple producer, single consumer queue of tasks.
+/// @note Any thread may post, only the thread that owns the queue may drain it. Tasks run in the order they were
+/// posted in. Posting is a single atomic exchange and never waits on the consumer.
+/// @note An executor for queued connections, see Signal::connect.
+class EventQueue {
+public:
+    EventQueue();
+    /// Pending tasks are destroyed without being run.
+    ~EventQueue();
+
+    /// Non-copyable / Non-movable
+    EventQueue(const EventQueue&) = delete;
+    EventQueue(EventQueue&&) = delete;
+    EventQueue& operator=(const EventQueue&) = delete;
+    EventQueue& operator=(EventQueue&&) = delete;
+
+    /// Post a task to the queue.
+    /// @note May be called from any thread.
+    void post(Task&& task);
+
+    /// Run tasks until the queue is empty.
+    /// @note Must only be called from the consuming thread. Tasks posted while draining are run as well.
+    /// @returns The number of tasks run.
+    std::size_t drain();
+
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        Task task;
+    };
+
+    /// Take the oldest task off the queue.
+    /// @returns True if a task was taken, false if the queue is empty.
+    bool pop(Task& task);
+
+    /// The most recently posted node, producers push here.
+    alignas(64) std::atomic<Node*> _head;
+    /// A node whose task has already been taken, its successor is the oldest pending task. Only the consumer accesses
+    /// this.
+    alignas(64) Node* _tail;
+};
+
+inline EventQueue::EventQueue()
+: _head{new Node}
+, _tail{_head.load(std::memory_order_relaxed)}
+{
+}
+
+inline EventQueue::~EventQueue()
+{
+    Task task{};
+    while (pop(task)) {
+    }
+    delete _tail;
+}
+
+inline void EventQueue::post(Task&& task)
+{
+    const auto node = new Node;
+    node->task = std::move(task);
+    const auto previous = _head.exchange(node, std::memory_order_acq_rel);
+    /// Until this store the consumer sees the queue end at previous, it picks node up on its next drain
+    previous->next.store(node, std::memory_order_release);
+}
+
+inline std::size_t EventQueue::drain()
+{
+    auto count = std::size_t{0u};
+    Task task{};
+    while (pop(task)) {
+        task();
+        ++count;
+    }
+    return count;
+}
+
+inline bool EventQueue::pop(Task& task)
+{
+    const auto tail = _tail;
+    const auto next = tail->next.load(std::memory_order_acquire);
+    if (!next) {
+        return false;
+    }
+    task = std::move(next->task);
+    _tail = next;
+    delete tail;
+    return true;
+}
+
+/// ]]] EventQueue ------------------------------------------------------------
+
+} // namespace moment
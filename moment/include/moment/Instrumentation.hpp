@@ -0,0 +1,485 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/// Instrumentation records how often signals are emitted, how many connections each emission visits and how long
+/// every slot takes. It is enabled per signal with the with_metrics policy, e.g.
+/// Signal<void(int), moment::with_metrics<moment::multi_threaded>>, and compiles out entirely otherwise. Metrics are
+/// keyed on the label a signal is constructed with and read through MetricsRegistry.
+
+namespace moment {
+
+/// [[[ MetricsClock ----------------------------------------------------------
+
+/// Timestamps for timing slots.
+/// @note Reads the time stamp counter on x86, so ticks are cycles of the reference clock. Elsewhere ticks are
+/// nanoseconds of std::chrono::steady_clock.
+struct MetricsClock {
+    static std::uint64_t now();
+};
+
+inline std::uint64_t MetricsClock::now()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    const auto time = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count());
+#endif
+}
+
+/// ]]] MetricsClock ----------------------------------------------------------
+
+/// [[[ StripedCounter --------------------------------------------------------
+
+/// A counter threads add to without contending with each other, the stripes are merged when it is read.
+/// @note Each thread is assigned a stripe on first use, threads only share a stripe once there are more of them than
+/// stripes.
+class StripedCounter {
+public:
+    void add(std::uint64_t value);
+
+    /// Get the sum of every stripe.
+    std::uint64_t load() const;
+
+private:
+    static constexpr std::size_t stripeCount = 16u;
+
+    struct alignas(64) Stripe {
+        std::atomic<std::uint64_t> value{0u};
+    };
+
+    /// Get the stripe of the calling thread.
+    static std::size_t stripe();
+
+    Stripe _stripes[stripeCount];
+};
+
+inline void StripedCounter::add(std::uint64_t value)
+{
+    _stripes[stripe()].value.fetch_add(value, std::memory_order_relaxed);
+}
+
+inline std::uint64_t StripedCounter::load() const
+{
+    auto sum = std::uint64_t{0u};
+    for (const auto& stripe : _stripes) {
+        sum += stripe.value.load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+inline std::size_t StripedCounter::stripe()
+{
+    static std::atomic<std::size_t> next{0u};
+    static thread_local const std::size_t stripe = next.fetch_add(1u, std::memory_order_relaxed) % stripeCount;
+    return stripe;
+}
+
+/// ]]] StripedCounter --------------------------------------------------------
+
+/// [[[ LatencyHistogram ------------------------------------------------------
+
+/// Counts durations in power of two buckets, bucket I counts durations of less than 2^I ticks and at least 2^(I-1).
+class LatencyHistogram {
+public:
+    static constexpr std::size_t bucketCount = 64u;
+    using Buckets = std::array<std::uint64_t, bucketCount>;
+
+    /// Count a duration.
+    /// @note May be called from any thread.
+    void record(std::uint64_t ticks);
+
+    /// Get the count of each bucket.
+    Buckets buckets() const;
+
+    /// Get an upper bound of the duration @p fraction of the recorded durations are shorter than, e.g. 0.99.
+    /// @returns The upper bound in ticks, zero if nothing was recorded.
+    static std::uint64_t percentile(const Buckets& buckets, double fraction);
+
+private:
+    std::atomic<std::uint64_t> _buckets[bucketCount]{};
+};
+
+inline void LatencyHistogram::record(std::uint64_t ticks)
+{
+#if defined(__GNUC__)
+    /// The bit width of ticks
+    const auto bucket = ticks == 0u ? 0u : std::min<std::size_t>(64u - __builtin_clzll(ticks), bucketCount - 1u);
+#else
+    auto bucket = std::size_t{0u};
+    while (ticks != 0u && bucket < bucketCount - 1u) {
+        ticks >>= 1u;
+        ++bucket;
+    }
+#endif
+    _buckets[bucket].fetch_add(1u, std::memory_order_relaxed);
+}
+
+inline auto LatencyHistogram::buckets() const -> Buckets
+{
+    auto buckets = Buckets{};
+    for (auto I = 0u; I < bucketCount; ++I) {
+        buckets[I] = _buckets[I].load(std::memory_order_relaxed);
+    }
+    return buckets;
+}
+
+inline std::uint64_t LatencyHistogram::percentile(const Buckets& buckets, double fraction)
+{
+    auto total = std::uint64_t{0u};
+    for (const auto count : buckets) {
+        total += count;
+    }
+    auto seen = std::uint64_t{0u};
+    for (auto I = 0u; I < bucketCount; ++I) {
+        seen += buckets[I];
+        if (seen != 0u && static_cast<double>(seen) >= fraction * static_cast<double>(total)) {
+            return std::uint64_t{1u} << I;
+        }
+    }
+    return 0u;
+}
+
+/// ]]] LatencyHistogram ------------------------------------------------------
+
+/// [[[ SignalMetrics ---------------------------------------------------------
+
+/// The metrics of every signal sharing a label.
+class SignalMetrics {
+public:
+    /// The metrics of one connection.
+    struct SlotMetrics {
+        const std::uint64_t connectionId;
+        LatencyHistogram calls;
+    };
+
+    /// The metrics of one connection at the time of a snapshot.
+    struct SlotSnapshot {
+        std::uint64_t connectionId;
+        LatencyHistogram::Buckets calls;
+    };
+
+    /// The metrics at the time of a snapshot.
+    struct Snapshot {
+        std::string label;
+        std::uint64_t emits;
+        std::uint64_t slotsVisited;
+        /// Only the connections that still exist.
+        std::vector<SlotSnapshot> slots;
+    };
+
+    explicit SignalMetrics(std::string label);
+
+    /// Non-copyable / Non-movable
+    SignalMetrics(const SignalMetrics&) = delete;
+    SignalMetrics(SignalMetrics&&) = delete;
+    SignalMetrics& operator=(const SignalMetrics&) = delete;
+    SignalMetrics& operator=(SignalMetrics&&) = delete;
+
+    const std::string& label() const;
+
+    /// Count @p emits emissions that visited @p slotsVisited connections in total, including dead ones.
+    void recordEmits(std::uint64_t emits, std::uint64_t slotsVisited);
+
+    /// Add the metrics of a new connection, they are dropped once the connection is gone.
+    std::shared_ptr<SlotMetrics> addSlot(std::uint64_t connectionId);
+
+    /// Get the current metrics.
+    Snapshot snapshot() const;
+
+private:
+    const std::string _label;
+    StripedCounter _emits;
+    StripedCounter _slotsVisited;
+    mutable std::mutex _slotsMutex;
+    /// Guarded by _slotsMutex, expired entries are dropped by snapshot and once the list doubles.
+    mutable std::vector<std::weak_ptr<SlotMetrics>> _slots;
+    std::size_t _pruneAt{16u};
+};
+
+inline SignalMetrics::SignalMetrics(std::string label)
+: _label{std::move(label)}
+{
+}
+
+inline const std::string& SignalMetrics::label() const
+{
+    return _label;
+}
+
+inline void SignalMetrics::recordEmits(std::uint64_t emits, std::uint64_t slotsVisited)
+{
+    _emits.add(emits);
+    _slotsVisited.add(slotsVisited);
+}
+
+inline auto SignalMetrics::addSlot(std::uint64_t connectionId) -> std::shared_ptr<SlotMetrics>
+{
+    auto slot = std::shared_ptr<SlotMetrics>{new SlotMetrics{connectionId, {}}};
+    std::lock_guard<std::mutex> lock{_slotsMutex};
+    if (_slots.size() >= _pruneAt) {
+        _slots.erase(std::remove_if(_slots.begin(), _slots.end(), [](const auto& slot) { return slot.expired(); }),
+                     _slots.end());
+        _pruneAt = std::max<std::size_t>(16u, 2u * _slots.size());
+    }
+    _slots.push_back(slot);
+    return slot;
+}
+
+inline auto SignalMetrics::snapshot() const -> Snapshot
+{
+    auto snapshot = Snapshot{_label, _emits.load(), _slotsVisited.load(), {}};
+    std::lock_guard<std::mutex> lock{_slotsMutex};
+    auto live = _slots.begin();
+    for (const auto& weakSlot : _slots) {
+        if (const auto slot = weakSlot.lock()) {
+            snapshot.slots.push_back(SlotSnapshot{slot->connectionId, slot->calls.buckets()});
+            *live++ = weakSlot;
+        }
+    }
+    _slots.erase(live, _slots.end());
+    return snapshot;
+}
+
+/// ]]] SignalMetrics ---------------------------------------------------------
+
+/// [[[ MetricsRegistry -------------------------------------------------------
+
+/// The metrics of every instrumented signal, by label.
+/// @note Metrics live as long as the program, signals only register their label once when constructed.
+class MetricsRegistry {
+public:
+    /// Get the registry shared by every signal.
+    static MetricsRegistry& instance();
+
+    /// Get the metrics of @p label, creating them if needed.
+    /// @note May be called from any thread.
+    std::shared_ptr<SignalMetrics> metrics(std::string_view label);
+
+    /// Get the current metrics of every label, ordered by label.
+    std::vector<SignalMetrics::Snapshot> snapshot() const;
+
+    /// Write the current metrics as text, one line per label followed by one line per connection.
+    void write(std::ostream& out) const;
+
+private:
+    mutable std::mutex _mutex;
+    /// Guarded by _mutex.
+    std::map<std::string, std::shared_ptr<SignalMetrics>, std::less<>> _metrics;
+};
+
+inline MetricsRegistry& MetricsRegistry::instance()
+{
+    static MetricsRegistry registry{};
+    return registry;
+}
+
+inline std::shared_ptr<SignalMetrics> MetricsRegistry::metrics(std::string_view label)
+{
+    std::lock_guard<std::mutex> lock{_mutex};
+    const auto found = _metrics.find(label);
+    if (found != _metrics.end()) {
+        return found->second;
+    }
+    auto metrics = std::make_shared<SignalMetrics>(std::string{label});
+    _metrics.emplace(std::string{label}, metrics);
+    return metrics;
+}
+
+inline std::vector<SignalMetrics::Snapshot> MetricsRegistry::snapshot() const
+{
+    auto metrics = std::vector<std::shared_ptr<SignalMetrics>>{};
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        for (const auto& entry : _metrics) {
+            metrics.push_back(entry.second);
+        }
+    }
+    auto snapshots = std::vector<SignalMetrics::Snapshot>{};
+    for (const auto& signal : metrics) {
+        snapshots.push_back(signal->snapshot());
+    }
+    return snapshots;
+}
+
+inline void MetricsRegistry::write(std::ostream& out) const
+{
+    for (const auto& signal : snapshot()) {
+        out << signal.label << " emits=" << signal.emits << " visited=" << signal.slotsVisited << '\n';
+        for (const auto& slot : signal.slots) {
+            auto calls = std::uint64_t{0u};
+            for (const auto count : slot.calls) {
+                calls += count;
+            }
+            out << "  connection=" << slot.connectionId << " calls=" << calls
+                << " p50<=" << LatencyHistogram::percentile(slot.calls, 0.5)
+                << " p99<=" << LatencyHistogram::percentile(slot.calls, 0.99) << '\n';
+        }
+    }
+}
+
+/// ]]] MetricsRegistry -------------------------------------------------------
+
+/// [[[ Instruments -----------------------------------------------------------
+
+/// The metrics a signal records into, empty unless Enabled.
+template <bool Enabled>
+class SignalInstrument {
+public:
+    SignalInstrument() = default;
+    explicit SignalInstrument(std::string_view) {}
+
+protected:
+    /// Records emissions into the metrics of a signal.
+    struct Recorder {
+        void recordEmits(std::size_t, std::size_t) const {}
+    };
+
+    Recorder recorder() const { return {}; }
+};
+
+template <>
+class SignalInstrument<true> {
+public:
+    SignalInstrument();
+    explicit SignalInstrument(std::string_view label);
+
+    SignalMetrics& metrics() const;
+
+protected:
+    /// Records emissions into the metrics of a signal.
+    /// @note The registry keeps the metrics alive, so a recorder may outlive the signal, e.g. when a slot destroyed it.
+    class Recorder {
+    public:
+        explicit Recorder(SignalMetrics* metrics);
+
+        /// Count @p emits emissions that visited @p slotsVisited connections in total.
+        void recordEmits(std::size_t emits, std::size_t slotsVisited) const;
+
+    private:
+        SignalMetrics* const _metrics;
+    };
+
+    Recorder recorder() const;
+
+private:
+    std::shared_ptr<SignalMetrics> _metrics;
+};
+
+inline SignalInstrument<true>::SignalInstrument()
+: SignalInstrument{"unlabeled"}
+{
+}
+
+inline SignalInstrument<true>::SignalInstrument(std::string_view label)
+: _metrics{MetricsRegistry::instance().metrics(label)}
+{
+}
+
+inline SignalMetrics& SignalInstrument<true>::metrics() const
+{
+    return *_metrics;
+}
+
+inline SignalInstrument<true>::Recorder::Recorder(SignalMetrics* metrics)
+: _metrics{metrics}
+{
+}
+
+inline void SignalInstrument<true>::Recorder::recordEmits(std::size_t emits, std::size_t slotsVisited) const
+{
+    _metrics->recordEmits(emits, slotsVisited);
+}
+
+inline auto SignalInstrument<true>::recorder() const -> Recorder
+{
+    return Recorder{_metrics.get()};
+}
+
+/// The metrics a connection records its calls into, empty unless Enabled.
+template <bool Enabled>
+class SlotInstrument {
+protected:
+    /// Times a call from construction to destruction.
+    struct Timer {
+    };
+
+    Timer time() const { return {}; }
+};
+
+template <>
+class SlotInstrument<true> {
+public:
+    /// Set the metrics to record into.
+    /// @note Only valid before the connection is connected to the signal.
+    void setMetrics(std::shared_ptr<SignalMetrics::SlotMetrics> metrics);
+
+protected:
+    /// Times a call from construction to destruction.
+    class Timer {
+    public:
+        explicit Timer(SignalMetrics::SlotMetrics* metrics);
+        ~Timer();
+
+        /// Non-copyable / Non-movable
+        Timer(const Timer&) = delete;
+        Timer(Timer&&) = delete;
+        Timer& operator=(const Timer&) = delete;
+        Timer& operator=(Timer&&) = delete;
+
+    private:
+        SignalMetrics::SlotMetrics* const _metrics;
+        const std::uint64_t _start;
+    };
+
+    Timer time() const;
+
+private:
+    std::shared_ptr<SignalMetrics::SlotMetrics> _metrics;
+};
+
+inline void SlotInstrument<true>::setMetrics(std::shared_ptr<SignalMetrics::SlotMetrics> metrics)
+{
+    _metrics = std::move(metrics);
+}
+
+inline SlotInstrument<true>::Timer::Timer(SignalMetrics::SlotMetrics* metrics)
+: _metrics{metrics}
+, _start{MetricsClock::now()}
+{
+}
+
+inline SlotInstrument<true>::Timer::~Timer()
+{
+    if (_metrics) {
+        _metrics->calls.record(MetricsClock::now() - _start);
+    }
+}
+
+inline auto SlotInstrument<true>::time() const -> Timer
+{
+    return Timer{_metrics.get()};
+}
+
+/// ]]] Instruments -----------------------------------------------------------
+
+} // namespace moment
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+namespace moment {
+
+/// [[[ IntrusivePtr ----------------------------------------------------------
+
+/// A shared pointer to an object that holds its own reference count.
+/// @note Unlike std::shared_ptr there is no separate control block, so sharing an object costs no extra allocation.
+/// @tparam T The object type, must provide retain() and release(), where release() destroys the object once the last
+/// reference is gone.
+template <typename T>
+class IntrusivePtr {
+public:
+    IntrusivePtr() = default;
+    IntrusivePtr(std::nullptr_t) {}
+    ~IntrusivePtr();
+
+    /// Construct a pointer taking a new reference to @p ptr.
+    explicit IntrusivePtr(T* ptr);
+
+    /// Copyable
+    IntrusivePtr(const IntrusivePtr& other);
+    IntrusivePtr& operator=(const IntrusivePtr& other);
+
+    /// Movable
+    IntrusivePtr(IntrusivePtr&& other) noexcept;
+    IntrusivePtr& operator=(IntrusivePtr&& other) noexcept;
+
+    T* get() const;
+    T* operator->() const;
+    T& operator*() const;
+    explicit operator bool() const;
+
+    bool operator==(const IntrusivePtr& other) const;
+    bool operator!=(const IntrusivePtr& other) const;
+
+    void swap(IntrusivePtr& other) noexcept;
+
+private:
+    T* _ptr{nullptr};
+};
+
+template <typename T>
+inline IntrusivePtr<T>::~IntrusivePtr()
+{
+    if (_ptr) {
+        _ptr->release();
+    }
+}
+
+template <typename T>
+inline IntrusivePtr<T>::IntrusivePtr(T* ptr)
+: _ptr{ptr}
+{
+    if (_ptr) {
+        _ptr->retain();
+    }
+}
+
+template <typename T>
+inline IntrusivePtr<T>::IntrusivePtr(const IntrusivePtr& other)
+: IntrusivePtr{other._ptr}
+{
+}
+
+template <typename T>
+inline IntrusivePtr<T>& IntrusivePtr<T>::operator=(const IntrusivePtr& other)
+{
+    IntrusivePtr{other}.swap(*this);
+    return *this;
+}
+
+template <typename T>
+inline IntrusivePtr<T>::IntrusivePtr(IntrusivePtr&& other) noexcept
+: _ptr{std::exchange(other._ptr, nullptr)}
+{
+}
+
+template <typename T>
+inline IntrusivePtr<T>& IntrusivePtr<T>::operator=(IntrusivePtr&& other) noexcept
+{
+    IntrusivePtr{std::move(other)}.swap(*this);
+    return *this;
+}
+
+template <typename T>
+inline T* IntrusivePtr<T>::get() const
+{
+    return _ptr;
+}
+
+template <typename T>
+inline T* IntrusivePtr<T>::operator->() const
+{
+    return _ptr;
+}
+
+template <typename T>
+inline T& IntrusivePtr<T>::operator*() const
+{
+    return *_ptr;
+}
+
+template <typename T>
+inline IntrusivePtr<T>::operator bool() const
+{
+    return _ptr != nullptr;
+}
+
+template <typename T>
+inline bool IntrusivePtr<T>::operator==(const IntrusivePtr& other) const
+{
+    return _ptr == other._ptr;
+}
+
+template <typename T>
+inline bool IntrusivePtr<T>::operator!=(const IntrusivePtr& other) const
+{
+    return _ptr != other._ptr;
+}
+
+template <typename T>
+inline void IntrusivePtr<T>::swap(IntrusivePtr& other) noexcept
+{
+    std::swap(_ptr, other._ptr);
+}
+
+/// ]]] IntrusivePtr ----------------------------------------------------------
+
+} // namespace moment
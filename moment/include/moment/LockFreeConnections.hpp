@@ -0,0 +1,376 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+#include <moment/EmitScope.hpp>
+#include <moment/MemoryResource.hpp>
+
+namespace moment {
+
+/// [[[ LockFreeConnections ---------------------------------------------------
+
+/// The connections of a signal, stored in a lock free singly linked list.
+/// @note Connect pushes a node at the head with a CAS, so the list is naturally in newest first order. Disconnect
+/// marks the connection as dead, once dead connections make up more than half of the list the list is rebuilt without
+/// them and swapped in with a CAS. When a slot disconnects, the rebuild is deferred until the outermost emission of the
+/// list on its thread ends. Emitting, connecting and disconnecting never block.
+/// @note Nodes are immutable once published. Unlinked nodes are reclaimed with two reader counts that alternate with
+/// an epoch: a retired node is only freed once every reader that started before it was unlinked is done, so memory
+/// is bounded even if emitters overlap continuously.
+/// @note Nodes are allocated from a memory resource, which must be thread safe as nodes are allocated and freed from
+/// any thread using the connections.
+/// @note Priorities are not supported.
+/// @tparam T A pointer to a connection, which provides valid() and invalidate().
+template <typename T>
+class LockFreeConnections {
+    struct Node {
+        T value;
+        /// Immutable once the node is published.
+        Node* next;
+        /// Links the node into the retired list, never read by emitters.
+        Node* retiredNext;
+    };
+
+public:
+    /// Connections are called newest first only.
+    static constexpr bool prioritized = false;
+    /// Views can only be iterated.
+    static constexpr bool contiguous = false;
+
+    /// The connections at the time the view was taken.
+    /// @note Nodes reachable from the view are not freed while it exists. Rebuilds the list once destroyed if a slot
+    /// deferred it. The store may be destroyed by a slot, if the connections own it.
+    class View {
+    public:
+        explicit View(LockFreeConnections& connections);
+        ~View();
+
+        /// Non-copyable / Non-movable
+        View(const View&) = delete;
+        View(View&&) = delete;
+        View& operator=(const View&) = delete;
+        View& operator=(View&&) = delete;
+
+        /// Calls @p func with each connection, in the order slots are called in.
+        /// @note If @p func returns a bool, stops at the first connection it returns false for.
+        template <typename Func>
+        void forEach(Func&& func) const;
+
+    private:
+        LockFreeConnections& _connections;
+        const std::size_t _epoch;
+        const Node* const _head;
+        EmitScope _scope;
+    };
+
+    /// @param resource The resource nodes are allocated from, must outlive the connections.
+    explicit LockFreeConnections(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    /// @note There must not be any views left.
+    ~LockFreeConnections();
+
+    /// Non-copyable / Non-movable
+    LockFreeConnections(const LockFreeConnections&) = delete;
+    LockFreeConnections(LockFreeConnections&&) = delete;
+    LockFreeConnections& operator=(const LockFreeConnections&) = delete;
+    LockFreeConnections& operator=(LockFreeConnections&&) = delete;
+
+    /// Get the current connections.
+    View view();
+
+    /// Add a connection, it is called before every existing connection.
+    void connect(T connection);
+
+    /// Invalidate and remove a connection.
+    /// @param connection Points to the connection, it need not own it.
+    /// @returns True if the connection was valid, false otherwise.
+    template <typename Ptr>
+    bool disconnect(const Ptr& connection);
+
+    /// Invalidate and remove all connections.
+    void clear();
+
+    /// Get the resource nodes are allocated from.
+    std::pmr::memory_resource* resource() const;
+
+private:
+    /// Register a reader, nodes it can reach are not freed until unpin.
+    /// @returns The epoch to pass to unpin.
+    std::size_t pin() const;
+    void unpin(std::size_t epoch) const;
+
+    /// Rebuild the list without dead connections.
+    /// @note Only one thread compacts at a time, others skip it.
+    void compact();
+    /// Hand over the unlinked chain starting at @p first to be freed once no reader can reach it.
+    void retire(Node* first);
+    /// Free retired nodes that no reader can reach any more.
+    /// @note Only one thread reclaims at a time, others skip it.
+    void reclaim() const;
+
+    /// Allocate a node that is not linked yet.
+    Node* makeNode(T value) const;
+    /// Free a chain linked by next.
+    void destroyChain(Node* first) const;
+    /// Free a chain linked by retiredNext.
+    void destroyRetired(Node* first) const;
+
+    std::pmr::memory_resource* const _resource;
+    std::atomic<Node*> _head{nullptr};
+    /// Number of nodes in the list and how many of them are dead, only used to decide when to compact.
+    std::atomic<std::ptrdiff_t> _size{0};
+    std::atomic<std::ptrdiff_t> _deadCount{0};
+    std::atomic<bool> _compacting{false};
+    /// Set when a slot disconnected enough connections to rebuild the list.
+    std::atomic<bool> _compactDeferred{false};
+
+    /// New readers register in _readers[_epoch % 2]. The epoch only advances once the other count is back to zero.
+    mutable std::atomic<std::size_t> _epoch{0u};
+    mutable std::atomic<std::size_t> _readers[2]{};
+    /// Retired since the epoch last advanced.
+    mutable std::atomic<Node*> _retired{nullptr};
+    /// Retired before the epoch last advanced, freed once _readers[(_epoch + 1) % 2] is zero.
+    mutable std::atomic<Node*> _limbo{nullptr};
+    mutable std::atomic<bool> _reclaiming{false};
+};
+
+template <typename T>
+inline LockFreeConnections<T>::View::View(LockFreeConnections& connections)
+: _connections{connections}
+, _epoch{connections.pin()}
+, _head{connections._head.load(std::memory_order_seq_cst)}
+, _scope{&connections}
+{
+}
+
+template <typename T>
+inline LockFreeConnections<T>::View::~View()
+{
+    const auto compact = _connections._compactDeferred.load(std::memory_order_relaxed) && _scope.outermost();
+    const auto reclaim =
+        _connections._retired.load(std::memory_order_relaxed) || _connections._limbo.load(std::memory_order_relaxed);
+    /// A slot may have destroyed the owner of the store, then the connections of unlinked nodes can hold the last
+    /// references to it and freeing them would destroy it. Read while pinned, so the node can not be freed yet.
+    const auto retained = (compact || reclaim) && _head ? _head->value : T{};
+    _connections.unpin(_epoch);
+    if (compact && _connections._compactDeferred.exchange(false, std::memory_order_relaxed)) {
+        _connections.compact();
+    }
+    if (_connections._retired.load(std::memory_order_relaxed) || _connections._limbo.load(std::memory_order_relaxed)) {
+        _connections.reclaim();
+    }
+}
+
+template <typename T>
+template <typename Func>
+inline void LockFreeConnections<T>::View::forEach(Func&& func) const
+{
+    for (auto node = _head; node; node = node->next) {
+        if constexpr (std::is_same<decltype(func(*node->value)), bool>::value) {
+            if (!func(*node->value)) {
+                return;
+            }
+        } else {
+            func(*node->value);
+        }
+    }
+}
+
+template <typename T>
+inline LockFreeConnections<T>::LockFreeConnections(std::pmr::memory_resource* resource)
+: _resource{resource}
+{
+}
+
+template <typename T>
+inline LockFreeConnections<T>::~LockFreeConnections()
+{
+    destroyChain(_head.load(std::memory_order_relaxed));
+    destroyRetired(_retired.load(std::memory_order_relaxed));
+    destroyRetired(_limbo.load(std::memory_order_relaxed));
+}
+
+template <typename T>
+inline auto LockFreeConnections<T>::view() -> View
+{
+    return View{*this};
+}
+
+template <typename T>
+inline void LockFreeConnections<T>::connect(T connection)
+{
+    const auto node = makeNode(std::move(connection));
+    /// Pinned so the head can not be freed and reused under the CAS
+    const auto epoch = pin();
+    auto head = _head.load(std::memory_order_relaxed);
+    do {
+        node->next = head;
+    } while (!_head.compare_exchange_weak(head, node, std::memory_order_seq_cst, std::memory_order_relaxed));
+    unpin(epoch);
+    _size.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename T>
+template <typename Ptr>
+inline bool LockFreeConnections<T>::disconnect(const Ptr& connection)
+{
+    if (!connection->invalidate()) {
+        return false;
+    }
+    const auto deadCount = _deadCount.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (2 * deadCount > _size.load(std::memory_order_relaxed)) {
+        if (EmitScope::active(this)) {
+            _compactDeferred.store(true, std::memory_order_relaxed);
+        } else {
+            compact();
+        }
+    }
+    return true;
+}
+
+template <typename T>
+inline void LockFreeConnections<T>::clear()
+{
+    /// Nobody else can retire the nodes we unlink, so they stay alive while we walk them
+    const auto head = _head.exchange(nullptr, std::memory_order_seq_cst);
+    auto count = std::ptrdiff_t{0};
+    auto deadCount = std::ptrdiff_t{0};
+    for (auto node = head; node; node = node->next) {
+        ++count;
+        if (!node->value->invalidate()) {
+            ++deadCount;
+        }
+    }
+    _size.fetch_sub(count, std::memory_order_relaxed);
+    _deadCount.fetch_sub(deadCount, std::memory_order_relaxed);
+    if (head) {
+        retire(head);
+    }
+    /// Twice, so without an emission in flight every retired node is freed right away. They hold connections, which
+    /// hold the store, so once the signal is destroyed nothing else would free them.
+    reclaim();
+    reclaim();
+}
+
+template <typename T>
+inline std::pmr::memory_resource* LockFreeConnections<T>::resource() const
+{
+    return _resource;
+}
+
+template <typename T>
+inline std::size_t LockFreeConnections<T>::pin() const
+{
+    for (;;) {
+        const auto epoch = _epoch.load(std::memory_order_seq_cst);
+        _readers[epoch % 2u].fetch_add(1u, std::memory_order_seq_cst);
+        /// If the epoch advanced in between we registered with a count the reclaimer may already have seen as zero
+        if (_epoch.load(std::memory_order_seq_cst) == epoch) {
+            return epoch;
+        }
+        _readers[epoch % 2u].fetch_sub(1u, std::memory_order_seq_cst);
+    }
+}
+
+template <typename T>
+inline void LockFreeConnections<T>::unpin(std::size_t epoch) const
+{
+    _readers[epoch % 2u].fetch_sub(1u, std::memory_order_seq_cst);
+}
+
+template <typename T>
+inline void LockFreeConnections<T>::compact()
+{
+    if (_compacting.exchange(true, std::memory_order_acquire)) {
+        return;
+    }
+    const auto epoch = pin();
+    auto head = _head.load(std::memory_order_seq_cst);
+    for (;;) {
+        Node* first = nullptr;
+        auto link = &first;
+        auto removed = std::ptrdiff_t{0};
+        for (auto node = head; node; node = node->next) {
+            if (node->value->valid()) {
+                *link = makeNode(node->value);
+                link = &(*link)->next;
+            } else {
+                ++removed;
+            }
+        }
+        if (_head.compare_exchange_strong(head, first, std::memory_order_seq_cst)) {
+            _size.fetch_sub(removed, std::memory_order_relaxed);
+            _deadCount.fetch_sub(removed, std::memory_order_relaxed);
+            if (head) {
+                retire(head);
+            }
+            break;
+        }
+        /// A connection was pushed or the list was cleared, the copy was never published so it can go right away
+        destroyChain(first);
+    }
+    unpin(epoch);
+    _compacting.store(false, std::memory_order_release);
+    reclaim();
+}
+
+template <typename T>
+inline void LockFreeConnections<T>::retire(Node* first)
+{
+    auto last = first;
+    for (; last->next; last = last->next) {
+        last->retiredNext = last->next;
+    }
+    auto retired = _retired.load(std::memory_order_relaxed);
+    do {
+        last->retiredNext = retired;
+    } while (!_retired.compare_exchange_weak(retired, first, std::memory_order_seq_cst, std::memory_order_relaxed));
+}
+
+template <typename T>
+inline void LockFreeConnections<T>::reclaim() const
+{
+    if (_reclaiming.exchange(true, std::memory_order_acquire)) {
+        return;
+    }
+    /// Readers registered with the other count started before the epoch advanced, and so before _limbo was retired.
+    /// Once they are done nothing can reach _limbo and the epoch may advance again.
+    const auto epoch = _epoch.load(std::memory_order_seq_cst);
+    if (_readers[(epoch + 1u) % 2u].load(std::memory_order_seq_cst) == 0u) {
+        destroyRetired(_limbo.exchange(nullptr, std::memory_order_relaxed));
+        if (const auto retired = _retired.exchange(nullptr, std::memory_order_seq_cst)) {
+            _limbo.store(retired, std::memory_order_relaxed);
+            _epoch.store(epoch + 1u, std::memory_order_seq_cst);
+        }
+    }
+    _reclaiming.store(false, std::memory_order_release);
+}
+
+template <typename T>
+inline auto LockFreeConnections<T>::makeNode(T value) const -> Node*
+{
+    return newObject<Node>(_resource, Node{std::move(value), nullptr, nullptr});
+}
+
+template <typename T>
+inline void LockFreeConnections<T>::destroyChain(Node* first) const
+{
+    while (first) {
+        deleteObject(_resource, std::exchange(first, first->next));
+    }
+}
+
+template <typename T>
+inline void LockFreeConnections<T>::destroyRetired(Node* first) const
+{
+    while (first) {
+        deleteObject(_resource, std::exchange(first, first->retiredNext));
+    }
+}
+
+/// ]]] LockFreeConnections ---------------------------------------------------
+
+} // namespace moment
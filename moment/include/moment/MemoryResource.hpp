@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+namespace moment {
+
+/// [[[ MemoryResource --------------------------------------------------------
+
+/// Allocate memory from @p resource.
+/// @note std::pmr::new_delete_resource() always uses the aligned operator new, which is markedly slower than the plain
+/// one, so the plain one is called directly when the alignment allows it.
+void* allocate(std::pmr::memory_resource* resource, std::size_t bytes, std::size_t alignment);
+
+/// Return memory made by allocate to @p resource.
+void deallocate(std::pmr::memory_resource* resource, void* memory, std::size_t bytes, std::size_t alignment) noexcept;
+
+/// Construct a @p T in memory allocated from @p resource.
+/// @returns The object, destroy it with deleteObject and the same resource.
+template <typename T, typename... Args>
+T* newObject(std::pmr::memory_resource* resource, Args&&... args);
+
+/// Destroy an object made by newObject and return its memory to @p resource.
+template <typename T>
+void deleteObject(std::pmr::memory_resource* resource, T* object) noexcept;
+
+/// Allocate an array of @p count default initialized @p T from @p resource.
+/// @returns The array, destroy it with deleteArray and the same resource and count.
+template <typename T>
+T* newArray(std::pmr::memory_resource* resource, std::size_t count);
+
+/// Destroy an array made by newArray and return its memory to @p resource.
+template <typename T>
+void deleteArray(std::pmr::memory_resource* resource, T* array, std::size_t count) noexcept;
+
+inline void* allocate(std::pmr::memory_resource* resource, std::size_t bytes, std::size_t alignment)
+{
+    if (resource == std::pmr::new_delete_resource() && alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        return ::operator new(bytes);
+    }
+    return resource->allocate(bytes, alignment);
+}
+
+inline void
+deallocate(std::pmr::memory_resource* resource, void* memory, std::size_t bytes, std::size_t alignment) noexcept
+{
+    if (resource == std::pmr::new_delete_resource() && alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        ::operator delete(memory);
+        return;
+    }
+    resource->deallocate(memory, bytes, alignment);
+}
+
+template <typename T, typename... Args>
+inline T* newObject(std::pmr::memory_resource* resource, Args&&... args)
+{
+    const auto memory = allocate(resource, sizeof(T), alignof(T));
+    try {
+        return new (memory) T(std::forward<Args>(args)...);
+    } catch (...) {
+        deallocate(resource, memory, sizeof(T), alignof(T));
+        throw;
+    }
+}
+
+template <typename T>
+inline void deleteObject(std::pmr::memory_resource* resource, T* object) noexcept
+{
+    object->~T();
+    deallocate(resource, object, sizeof(T), alignof(T));
+}
+
+template <typename T>
+inline T* newArray(std::pmr::memory_resource* resource, std::size_t count)
+{
+    const auto array = static_cast<T*>(allocate(resource, count * sizeof(T), alignof(T)));
+    try {
+        std::uninitialized_default_construct_n(array, count);
+    } catch (...) {
+        deallocate(resource, array, count * sizeof(T), alignof(T));
+        throw;
+    }
+    return array;
+}
+
+template <typename T>
+inline void deleteArray(std::pmr::memory_resource* resource, T* array, std::size_t count) noexcept
+{
+    std::destroy_n(array, count);
+    deallocate(resource, array, count * sizeof(T), alignof(T));
+}
+
+/// ]]] MemoryResource --------------------------------------------------------
+
+} // namespace moment
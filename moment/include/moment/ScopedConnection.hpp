@@ -0,0 +1,200 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <moment/Delegate.hpp>
+#include <moment/Signal.hpp>
+
+namespace moment {
+
+/// [[[ ScopedConnection ------------------------------------------------------
+
+/// A connection that is disconnected when it goes out of scope.
+/// @note Safe to destroy after the signal, the connection is then already invalid.
+template <typename SlotProto, typename Policy = multi_threaded>
+class ScopedConnection {
+public:
+    ScopedConnection() = default;
+    /// Take ownership of @p connection.
+    ScopedConnection(Connection<SlotProto, Policy> connection);
+    ~ScopedConnection();
+
+    /// Non-copyable
+    ScopedConnection(const ScopedConnection&) = delete;
+    ScopedConnection& operator=(const ScopedConnection&) = delete;
+
+    /// Movable, assigning disconnects the connection held before.
+    ScopedConnection(ScopedConnection&& other) noexcept;
+    ScopedConnection& operator=(ScopedConnection&& other) noexcept;
+
+    /// Disconnect the connection from the signal.
+    /// @returns True if the connection was disconnected, false otherwise.
+    bool disconnect();
+
+    /// Get the validity of the connection.
+    /// @returns true if the connection is valid, false otherwise.
+    bool valid() const;
+
+    /// Stop managing the connection, it is left connected.
+    /// @returns The connection.
+    Connection<SlotProto, Policy> release();
+
+private:
+    Connection<SlotProto, Policy> _connection;
+};
+
+template <typename SlotProto, typename Policy>
+inline ScopedConnection<SlotProto, Policy>::ScopedConnection(Connection<SlotProto, Policy> connection)
+: _connection{std::move(connection)}
+{
+}
+
+template <typename SlotProto, typename Policy>
+inline ScopedConnection<SlotProto, Policy>::~ScopedConnection()
+{
+    _connection.disconnect();
+}
+
+template <typename SlotProto, typename Policy>
+inline ScopedConnection<SlotProto, Policy>::ScopedConnection(ScopedConnection&& other) noexcept
+: _connection{other.release()}
+{
+}
+
+template <typename SlotProto, typename Policy>
+inline ScopedConnection<SlotProto, Policy>& ScopedConnection<SlotProto, Policy>::operator=(
+    ScopedConnection&& other) noexcept
+{
+    if (this != &other) {
+        _connection.disconnect();
+        _connection = other.release();
+    }
+    return *this;
+}
+
+template <typename SlotProto, typename Policy>
+inline bool ScopedConnection<SlotProto, Policy>::disconnect()
+{
+    return _connection.disconnect();
+}
+
+template <typename SlotProto, typename Policy>
+inline bool ScopedConnection<SlotProto, Policy>::valid() const
+{
+    return _connection.valid();
+}
+
+template <typename SlotProto, typename Policy>
+inline Connection<SlotProto, Policy> ScopedConnection<SlotProto, Policy>::release()
+{
+    return std::exchange(_connection, Connection<SlotProto, Policy>{});
+}
+
+/// ]]] ScopedConnection ------------------------------------------------------
+
+/// [[[ ConnectionGroup -------------------------------------------------------
+
+/// Owns connections to any number of signals, of any signature, and disconnects them all at once.
+/// @note Disconnecting only marks a connection dead in its signal, signals compact once dead connections make up more
+/// than half of them. Tearing down a group of m connections is O(m) amortized no matter how many connections the
+/// signals hold.
+/// @note Not thread safe, the signals themselves may be used from other threads meanwhile.
+class ConnectionGroup {
+public:
+    ConnectionGroup() = default;
+    /// Disconnects every connection.
+    ~ConnectionGroup();
+
+    /// Non-copyable
+    ConnectionGroup(const ConnectionGroup&) = delete;
+    ConnectionGroup& operator=(const ConnectionGroup&) = delete;
+
+    /// Movable, assigning disconnects the connections held before.
+    ConnectionGroup(ConnectionGroup&& other) noexcept = default;
+    ConnectionGroup& operator=(ConnectionGroup&& other) noexcept;
+
+    /// Take ownership of @p connection.
+    template <typename SlotProto, typename Policy>
+    void add(Connection<SlotProto, Policy> connection);
+
+    /// Disconnect every connection and empty the group.
+    void disconnect();
+
+    /// Get the number of connections owned, including those disconnected elsewhere that were not dropped yet.
+    std::size_t size() const;
+    bool empty() const;
+
+private:
+    /// Holds a connection, a connection is a single pointer so it is always stored inline.
+    /// Called with true disconnects the connection, with false only gets its validity.
+    using Entry = Delegate<bool(bool), 2 * sizeof(void*)>;
+
+    /// Drop connections disconnected elsewhere, so a long lived group does not grow without bound.
+    void prune();
+
+    std::vector<Entry> _connections;
+    /// The size at which add next prunes, doubled each time so pruning is O(1) amortized.
+    std::size_t _pruneAt{16u};
+};
+
+inline ConnectionGroup::~ConnectionGroup()
+{
+    disconnect();
+}
+
+inline ConnectionGroup& ConnectionGroup::operator=(ConnectionGroup&& other) noexcept
+{
+    if (this != &other) {
+        disconnect();
+        _connections = std::move(other._connections);
+        _pruneAt = other._pruneAt;
+    }
+    return *this;
+}
+
+template <typename SlotProto, typename Policy>
+inline void ConnectionGroup::add(Connection<SlotProto, Policy> connection)
+{
+    if (_connections.size() >= _pruneAt) {
+        prune();
+    }
+    _connections.emplace_back([connection = std::move(connection)](bool disconnect) mutable {
+        return disconnect ? connection.disconnect() : connection.valid();
+    });
+}
+
+inline void ConnectionGroup::disconnect()
+{
+    /// Taken out first so a slot destroyed by a disconnect may safely touch the group
+    auto connections = std::move(_connections);
+    _connections.clear();
+    for (auto& connection : connections) {
+        connection(true);
+    }
+}
+
+inline std::size_t ConnectionGroup::size() const
+{
+    return _connections.size();
+}
+
+inline bool ConnectionGroup::empty() const
+{
+    return _connections.empty();
+}
+
+inline void ConnectionGroup::prune()
+{
+    _connections.erase(std::remove_if(_connections.begin(),
+                                      _connections.end(),
+                                      [](Entry& connection) { return !connection(false); }),
+                       _connections.end());
+    _pruneAt = std::max<std::size_t>(16u, 2u * _connections.size());
+}
+
+/// ]]] ConnectionGroup -------------------------------------------------------
+
+} // namespace moment
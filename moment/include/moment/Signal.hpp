@@ -1,264 +1,689 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <mutex>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <iostream>
 
-/// The follwoing structs allow for a variable number of placeholders in a
-/// std::bind call based off the number of parameters to the signal.
-/// [[[ PlaceholderTemplate ---------------------------------------------------
-
-namespace moment {
-
-/// struct to aid in std::placeholder expansion
-/// @note Used to convert a size_t to a std::placeholder value
-template <std::size_t>
-struct PlaceholderTemplate {
-};
-
-} // namespace moment
-
-namespace std {
-
-/// is_placeholder template specialization to convert an index to a placeholder type.
-/// @note The off by one is due to std::placeholders being 1 indexed rather 0 indexed.
-template <std::size_t N>
-struct is_placeholder<moment::PlaceholderTemplate<N>> : integral_constant<std::size_t, N + 1> {
-};
-
-} // namespace std
-
-/// ]]] PlaceholderTemplate ---------------------------------------------------
+#include <moment/Combiners.hpp>
+#include <moment/Delegate.hpp>
+#include <moment/EventQueue.hpp>
+#include <moment/Instrumentation.hpp>
+#include <moment/IntrusivePtr.hpp>
+#include <moment/MemoryResource.hpp>
+#include <moment/ThreadPool.hpp>
+#include <moment/ThreadingPolicy.hpp>
 
 namespace moment {
 
 /// Generic template declarations. Signal and Connection are template specializations to allow for
 /// Signal<void(int, int)> vs Signal<void, int, int>
+/// @tparam Policy The threading policy, see ThreadingPolicy.hpp.
 
-template <typename>
+template <typename, typename Policy = multi_threaded>
 class Signal;
 
-template <typename>
+template <typename, typename Policy = multi_threaded>
 class Connection;
 
+/// See Trackable.hpp.
+class Trackable;
+
+/// Coroutine support needs C++20, see Awaitable.hpp.
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define MOMENT_COROUTINES 1
+
+template <typename, typename Policy = multi_threaded>
+class SignalAwaiter;
+#endif
+
+/// Merges the emissions of a coalesced connection by keeping the arguments of the latest one, see
+/// Signal::connectCoalesced.
+struct keep_latest {};
+
 /// [[[ Signal ----------------------------------------------------------------
 
 /// A signal class that defines a callable function that will notify all connected slots.
-/// @note Return values will be ignored
-template <typename Ret, typename... Params>
-class Signal<Ret(Params...)> {
+/// @note Return values are ignored by emit, see emitCombined to aggregate them. Signals returning Handled are the
+/// exception, emit stops at the first slot that returns Handled::Yes.
+/// @note Emission works on a view of the connections taken when it starts, so signals can be emitted from several
+/// threads at once and slots may connect / disconnect on the signal they are called from. How connections are stored
+/// is up to the policy, by default see CopyOnWriteConnections.
+/// @note Slots are called in order of priority, highest first, and newest first within a priority. The list is kept
+/// sorted when connecting, so emitting is always a linear scan.
+/// @note With an instrumented policy every emission and slot call is recorded, see Instrumentation.hpp. Otherwise
+/// instrumentation takes no space and no time.
+/// @note The connections are stored on the heap and connections point to them rather than to the signal, so moving
+/// a signal is O(1) and never touches its connections. A moved from signal may only be destroyed or assigned to.
+/// Connections share ownership of the store, so a connection may be disconnected while its signal is destroyed.
+/// @note The connections, their storage and the slots the signal wraps itself are allocated from a memory resource,
+/// std::pmr::get_default_resource() unless one is given. Slots passed in are stored as they were built, build them
+/// with std::allocator_arg and resource() to allocate large slots from the resource too.
+template <typename Ret, typename... Params, typename Policy>
+class Signal<Ret(Params...), Policy> : private SignalInstrument<Policy::instrumented> {
 public:
     using SlotProto = Ret(Params...);
-    using Slot = std::function<SlotProto>;
+    using Slot = Delegate<SlotProto>;
+    /// The arguments of one emission in a batch.
+    using BatchItem = typename Connection<SlotProto, Policy>::BatchItem;
+    /// A slot that receives a whole batch at once.
+    using BatchSlot = typename Connection<SlotProto, Policy>::BatchSlot;
+    /// Handled if the slots return Handled, void otherwise.
+    using EmitResult = std::conditional_t<std::is_same<Ret, Handled>::value, Handled, void>;
 
     ~Signal();
     Signal() = default;
 
+    /// Construct a labelled signal, signals sharing a label share their metrics.
+    /// @note The label is only used by instrumented policies.
+    explicit Signal(std::string_view label);
+
+    /// Construct a signal allocating from @p resource.
+    /// @param resource Must outlive the signal and its connections, and be thread safe unless the policy is
+    /// single_threaded.
+    explicit Signal(std::pmr::memory_resource* resource);
+
+    /// Construct a labelled signal allocating from @p resource.
+    Signal(std::string_view label, std::pmr::memory_resource* resource);
+
     /// Movable
-    Signal(Signal&& other);
-    Signal& operator=(Signal&& other);
+    Signal(Signal&& other) noexcept;
+    Signal& operator=(Signal&& other) noexcept;
 
     /// Non-copyable
     Signal(const Signal&) = delete;
     Signal& operator=(const Signal&) = delete;
 
     /// Connect a member function via c function ptr to this signal.
+    /// @note The object and member function are stored inline in the slot, this never allocates.
+    /// @note If @p object derives from Trackable the connection is disconnected when it is destroyed.
     /// @tparam Obj The object type.
     /// @tparam MemFunc The member fuction type.
     /// @param object The object to bind to.
     /// @param memFunc The member function to bind to.
     /// @returns The connection created.
     template <typename Obj, typename MemFunc>
-    Connection<Ret(Params...)> connect(Obj* object, MemFunc Obj::*memFunc);
+    Connection<Ret(Params...), Policy> connect(Obj* object, MemFunc Obj::*memFunc);
 
     /// Connect a member function via std::mem_fn to this signal.
+    /// @note If @p object derives from Trackable the connection is disconnected when it is destroyed.
     /// @tparam Obj The object type.
     /// @tparam MemFunc The member fuction type.
     /// @param object The object to bind to.
     /// @param memFunc The member function to bind to.
     /// @returns The connection created.
-    template <typename Obj, typename MemFunc>
-    Connection<Ret(Params...)> connect(Obj* object, MemFunc&& memFunc);
+    template <typename Obj,
+              typename MemFunc,
+              typename = std::enable_if_t<std::is_invocable<MemFunc&, Obj*, ArgRef<Params>...>::value>>
+    Connection<Ret(Params...), Policy> connect(Obj* object, MemFunc&& memFunc);
 
     /// Connect a slot to this signal.
     /// @param slot The slot to connect the signal to.
     /// @returns The connection created.
-    Connection<Ret(Params...)> connect(Slot&& slot);
+    Connection<Ret(Params...), Policy> connect(Slot&& slot);
+
+    /// Connect a slot to this signal with a priority.
+    /// @note Connecting at the highest priority so far is O(1) amortized, any lower priority copies the list.
+    /// @param slot The slot to connect the signal to.
+    /// @param priority Slots with a higher priority are called first, connect uses 0.
+    /// @returns The connection created.
+    Connection<Ret(Params...), Policy> connect(Slot&& slot, int priority);
+
+    /// Connect a slot that is called at most once.
+    /// @note The connection is disconnected right before the slot is called, so the slot is called exactly once even
+    /// if the signal is emitted from several threads at once.
+    /// @param slot The slot to connect the signal to.
+    /// @returns The connection created.
+    Connection<Ret(Params...), Policy> connectOnce(Slot&& slot);
+
+#if MOMENT_COROUTINES
+    /// Await the next emission, e.g. const auto value = co_await signal.next();
+    /// @note The coroutine is resumed on the emitting thread. co_await yields nothing, the argument, or a tuple of
+    /// the arguments. See SignalStream to await every emission.
+    SignalAwaiter<Ret(Params...), Policy> next();
+
+    /// Await the next emission, resuming through an executor.
+    /// @note Emitting posts the coroutine to @p executor rather than resuming it on the emitting thread.
+    /// @tparam Executor Any type with a post(Task&&) member that is safe to call from the emitting threads.
+    template <typename Executor>
+    SignalAwaiter<Ret(Params...), Policy> next(Executor& executor);
+#endif
+
+    /// Connect a slot that is called through an executor rather than on the emitting thread.
+    /// @note Emitting copies the arguments into a task and posts it to @p executor, so the emitter never waits on the
+    /// slot. A task that runs after the connection was disconnected does nothing.
+    /// @note Reference parameters refer to the copy of the argument held by the task.
+    /// @tparam Executor Any type with a post(Task&&) member that is safe to call from the emitting threads, e.g.
+    /// EventQueue.
+    /// @param slot The slot to connect the signal to.
+    /// @param executor The executor to run the slot on, must outlive the connection.
+    /// @returns The connection created.
+    template <typename Executor>
+    Connection<Ret(Params...), Policy> connect(Slot&& slot, Executor& executor);
+
+    /// Connect a slot that is called through an executor once for all the emissions since it last ran.
+    /// @note Only the first emission after the slot ran posts a task, later ones are merged into the pending arguments
+    /// without allocating or posting. The slot runs at most once per drain of @p executor, so draining on a timer or
+    /// once per frame bounds how often it is called however often the signal is emitted.
+    /// @note Reference parameters refer to the merged copy of the arguments.
+    /// @tparam Executor Any type with a post(Task&&) member that is safe to call from the emitting threads, e.g.
+    /// EventQueue.
+    /// @tparam Merge keep_latest, or a callable taking references to the pending arguments followed by the arguments
+    /// of the new emission, e.g. [](int& pending, int value) { pending += value; }.
+    /// @param slot The slot to connect the signal to.
+    /// @param executor The executor to run the slot on, must outlive the connection.
+    /// @param merge Merges an emission into the pending arguments, called under a lock.
+    /// @returns The connection created.
+    template <typename Executor, typename Merge = keep_latest>
+    Connection<Ret(Params...), Policy> connectCoalesced(Slot&& slot, Executor& executor, Merge merge = {});
+
+    /// Connect a slot that receives batches as a whole rather than one item at a time.
+    /// @note When emitted normally the slot receives a batch of one item.
+    /// @param slot The slot to connect the signal to, called with a pointer to the items and their count.
+    /// @returns The connection created.
+    Connection<Ret(Params...), Policy> connectBatch(BatchSlot&& slot);
 
     /// Disonnect a connection from this signal.
     /// @param connection The connection to disconnect from the signal.
     /// @returns True if disconnected, false otherwise.
-    bool disconnect(Connection<SlotProto>& connection);
+    bool disconnect(Connection<SlotProto, Policy>& connection);
 
     /// Disonnect all connections from this signal.
     /// @returns True if disconnected, false otherwise.
     void disconnect();
 
     /// Emit the signal.
-    /// @tparam Args The arguments to the slot
-    template <typename... Args>
-    void operator()(Args...);
+    /// @see emit
+    EmitResult operator()(ArgRef<Params>... args);
+
+    /// Emit the signal.
+    /// @note Every slot is passed the same references to @p args, arguments are never copied on the way to a slot.
+    /// @note If the slots return Handled, stops at the first slot that handled the emission.
+    /// @returns Whether a slot handled the emission if the slots return Handled.
+    EmitResult emit(ArgRef<Params>... args);
+
+    /// Emit the signal, moving @p args into the last slot called.
+    /// @note Every other slot is passed references to @p args as with emit.
+    void emitMove(Params&&... args);
+
+    /// Emit the signal, calling the slots concurrently on an executor.
+    /// @note The connections are split into chunks of @p chunkSize slots, the calling thread runs the first chunk
+    /// and the others are posted to @p executor. Returns once every chunk is done. Slots are called in no particular
+    /// order and must be safe to call concurrently.
+    /// @tparam Executor Any type with a post(Task&&) member that runs tasks on other threads, e.g. ThreadPool.
+    /// @param executor The executor to run the chunks on.
+    /// @param chunkSize The number of slots each task calls, must not be zero.
+    template <typename Executor>
+    void emitParallel(Executor& executor, std::size_t chunkSize, ArgRef<Params>... args);
+
+    /// Emit the signal once for each item in a batch.
+    /// @note The connections are only read once for the whole batch. Each slot is called with every item before the
+    /// next slot is called, slots connected with connectBatch are called once with all of the items.
+    /// @param items The arguments of each emission.
+    /// @param count The number of items.
+    void emitBatch(const BatchItem* items, std::size_t count);
+
+    /// Emit the signal once for each item in a contiguous container of BatchItem, e.g. std::vector.
+    /// @see emitBatch
+    template <typename Items>
+    void emitBatch(const Items& items);
+
+    /// Emit the signal, combining the values returned by the slots.
+    /// @note Slots are called in the same order as with emit, until @p combiner asks to stop.
+    /// @tparam Combiner The combiner type, see Combiners.hpp.
+    /// @param combiner The combiner the return values are passed to.
+    /// @returns The result of @p combiner.
+    template <typename Combiner>
+    auto emitCombined(Combiner combiner, ArgRef<Params>... args) -> decltype(combiner.result());
+
+    /// Get the metrics of this signal.
+    /// @note Only available with an instrumented policy.
+    const SignalMetrics& metrics() const;
+
+    /// Get the memory resource this signal allocates from.
+    std::pmr::memory_resource* resource() const;
+
+    /// @returns True if no slot is connected.
+    /// @note O(n) in the connections, slots connected or disconnected concurrently may or may not be seen.
+    bool empty() const;
 
 private:
-    using StateLock = std::lock_guard<std::mutex>;
-    using ConnectionData = typename Connection<SlotProto>::ConnectionData;
-    using SharedConnectionData = std::shared_ptr<ConnectionData>;
+    using Instrument = SignalInstrument<Policy::instrumented>;
+    using ConnectionData = typename Connection<SlotProto, Policy>::ConnectionData;
+    using SharedConnectionData = IntrusivePtr<ConnectionData>;
+    using Connections = typename Policy::template Connections<SharedConnectionData>;
+
+    using ConnectionsPtr = typename Connection<SlotProto, Policy>::SharedConnections;
+
+    /// Allocate the connections of a signal from @p resource.
+    static ConnectionsPtr makeConnections(std::pmr::memory_resource* resource);
+
+    /// The slot of a queued connection, posts the call to an executor.
+    template <typename Executor>
+    struct QueuedSlot {
+        void operator()(ArgRef<Params>... args) const;
+
+        /// The connection this is the slot of, not retained as it owns this.
+        ConnectionData* connection;
+        Executor* executor;
+        Slot slot;
+    };
+
+    /// Merges emissions into pending arguments and posts the slot to an executor, see connectCoalesced.
+    template <typename Executor, typename Merge>
+    struct CoalescedSlot {
+        /// Held by pointer as the mutex can not be moved, posted tasks reach it through the connection they retain.
+        struct Pending {
+            typename Policy::Mutex mutex;
+            /// The merged arguments, set while a task is posted.
+            std::optional<std::tuple<std::decay_t<Params>...>> values;
+        };
+
+        void operator()(ArgRef<Params>... args);
+
+        /// The connection this is the slot of, not retained as it owns this.
+        ConnectionData* connection;
+        Executor* executor;
+        Slot slot;
+        Merge merge;
+        typename Policy::template SharedPtr<Pending> pending;
+    };
 
-    /// Connect a member function
-    template <typename Obj, typename MemFunc, std::size_t... Indices>
-    Connection<SlotProto> connectBind(Obj* object, MemFunc Obj::*memFunc, std::index_sequence<Indices...>);
     /// Connect a member function
     template <typename Obj, typename MemFunc>
-    Connection<SlotProto> connectBind(Obj* object, MemFunc&& memFunc);
-    /// Connect a slot to this signal under a lock.
-    /// @returns The connection created.
-    Connection<SlotProto> connectLocked(const StateLock&, Slot&& slot);
-    /// Disconnect a slot from this signal under a lock.
-    /// @returns True if disconnected, false otherwise.
-    bool disconnectLocked(const StateLock&, Connection<SlotProto>& connection);
-    /// Disconnect all slots from this signal under a lock.
-    void disconnectAllLocked(const StateLock&);
-    /// Calls @p func with each connection.
-    void forEachConnection(const StateLock&, std::function<void(ConnectionData&)>&& func);
-
-    mutable std::mutex _stateMutex;
-    std::vector<SharedConnectionData> _connections;
-    bool _valid{true};
+    Connection<SlotProto, Policy> connectBind(Obj* object, MemFunc&& memFunc);
+
+    /// Register @p connection with @p object if it is Trackable.
+    /// @returns The connection.
+    template <typename Obj>
+    static Connection<SlotProto, Policy> track(Obj* object, Connection<SlotProto, Policy> connection);
+    /// Add a connection to this signal.
+    /// @returns The connection.
+    Connection<SlotProto, Policy> connectData(SharedConnectionData connection);
+
+    /// Null once moved from.
+    ConnectionsPtr _connections{makeConnections(std::pmr::get_default_resource())};
 };
 
-template <typename Ret, typename... Params>
-inline Signal<Ret(Params...)>::~Signal()
+template <typename Ret, typename... Params, typename Policy>
+inline Signal<Ret(Params...), Policy>::~Signal()
+{
+    disconnect();
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline Signal<Ret(Params...), Policy>::Signal(std::string_view label)
+: Instrument{label}
+{
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline Signal<Ret(Params...), Policy>::Signal(std::pmr::memory_resource* resource)
+: _connections{makeConnections(resource)}
+{
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline Signal<Ret(Params...), Policy>::Signal(std::string_view label, std::pmr::memory_resource* resource)
+: Instrument{label}
+, _connections{makeConnections(resource)}
 {
-    StateLock lock{_stateMutex};
-    disconnectAllLocked(lock);
 }
 
-template <typename Ret, typename... Params>
-inline Signal<Ret(Params...)>::Signal(Signal&& other)
+template <typename Ret, typename... Params, typename Policy>
+inline Signal<Ret(Params...), Policy>::Signal(Signal&& other) noexcept
+: Instrument{other}
+, _connections{std::move(other._connections)}
 {
-    StateLock thisLock{_stateMutex};
-    StateLock otherLock{other._stateMutex};
-    disconnectAllLocked(thisLock);
-    _connections = std::move(other._connections);
-    other._connections.clear();
-    other._valid = false;
-    _valid = true;
-    forEachConnection(thisLock, [this](auto& connection) { connection.updateSignal(this); });
 }
 
-template <typename Ret, typename... Params>
-inline Signal<Ret(Params...)>& Signal<Ret(Params...)>::operator=(Signal&& other)
+template <typename Ret, typename... Params, typename Policy>
+inline Signal<Ret(Params...), Policy>& Signal<Ret(Params...), Policy>::operator=(Signal&& other) noexcept
 {
-    StateLock thisLock{_stateMutex};
-    StateLock otherLock{other._stateMutex};
-    disconnectAllLocked(thisLock);
-    _connections = std::move(other._connections);
-    other._connections.clear();
-    other._valid = false;
-    _valid = true;
-    forEachConnection(thisLock, [this](auto& connection) { connection.updateSignal(this); });
+    if (this != &other) {
+        disconnect();
+        Instrument::operator=(other);
+        _connections = std::move(other._connections);
+    }
     return *this;
 }
 
-template <typename Ret, typename... Params>
-template <typename... Args>
-inline void Signal<Ret(Params...)>::operator()(Args... args)
+template <typename Ret, typename... Params, typename Policy>
+inline auto Signal<Ret(Params...), Policy>::operator()(ArgRef<Params>... args) -> EmitResult
+{
+    return emit(std::forward<ArgRef<Params>>(args)...);
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline auto Signal<Ret(Params...), Policy>::emit(ArgRef<Params>... args) -> EmitResult
+{
+    if constexpr (std::is_same<Ret, Handled>::value) {
+        return emitCombined(until_handled{}, std::forward<ArgRef<Params>>(args)...);
+    } else {
+        assert(_connections);
+        const auto connections = _connections->view();
+        if constexpr (Policy::instrumented) {
+            /// A slot may destroy the signal, so nothing of it is used once the slots were called
+            const auto recorder = Instrument::recorder();
+            auto visited = std::size_t{0u};
+            connections.forEach([&visited, &args...](auto& connection) {
+                ++visited;
+                connection.call(std::forward<ArgRef<Params>>(args)...);
+            });
+            recorder.recordEmits(1u, visited);
+        } else {
+            connections.forEach(
+                [&args...](auto& connection) { connection.call(std::forward<ArgRef<Params>>(args)...); });
+        }
+    }
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline void Signal<Ret(Params...), Policy>::emitMove(Params&&... args)
 {
-    StateLock lock{_stateMutex};
-    assert(_valid);
-    forEachConnection(lock, [tup{std::make_tuple(std::forward<Args>(args)...)}](auto& connection) {
-        std::apply([&connection](auto const&... args) { connection.call(args...); }, tup);
+    assert(_connections);
+    const auto connections = _connections->view();
+    const auto recorder = Instrument::recorder();
+    /// Call each connection once the next one is known, so the last one is left over
+    ConnectionData* previous = nullptr;
+    auto visited = std::size_t{0u};
+    connections.forEach([&previous, &visited, &args...](auto& connection) {
+        if (previous) {
+            previous->call(args...);
+        }
+        previous = &connection;
+        ++visited;
     });
+    if (previous) {
+        previous->callMove(std::forward<Params>(args)...);
+    }
+    recorder.recordEmits(1u, visited);
 }
 
-template <typename Ret, typename... Params>
-template <typename Obj, typename MemFunc>
-inline Connection<Ret(Params...)> Signal<Ret(Params...)>::connect(Obj* object, MemFunc Obj::*memFunc)
+template <typename Ret, typename... Params, typename Policy>
+template <typename Executor>
+inline void Signal<Ret(Params...), Policy>::emitParallel(Executor& executor,
+                                                         std::size_t chunkSize,
+                                                         ArgRef<Params>... args)
 {
-    return connectBind(object, memFunc, std::make_index_sequence<sizeof...(Params)>{});
+    static_assert(Connections::contiguous, "emitParallel is not supported by this threading policy");
+    assert(chunkSize > 0u);
+    assert(_connections);
+    const auto connections = _connections->view();
+    const auto count = connections.size();
+    Instrument::recorder().recordEmits(1u, count);
+    if (count == 0u) {
+        return;
+    }
+    const auto callRange = [&args...](const SharedConnectionData* first, const SharedConnectionData* last) {
+        for (auto I = first; I != last; ++I) {
+            (*I)->call(std::forward<ArgRef<Params>>(args)...);
+        }
+    };
+    /// The tasks only reference state on this stack frame, which outlives them as we wait for every one
+    const auto first = connections.data();
+    const auto chunkCount = (count + chunkSize - 1u) / chunkSize;
+    Latch done{chunkCount - 1u};
+    for (auto chunk = std::size_t{1u}; chunk < chunkCount; ++chunk) {
+        const auto chunkFirst = first + chunk * chunkSize;
+        const auto chunkLast = first + std::min(count, (chunk + 1u) * chunkSize);
+        executor.post([&callRange, &done, chunkFirst, chunkLast]() {
+            callRange(chunkFirst, chunkLast);
+            done.countDown();
+        });
+    }
+    callRange(first, first + std::min(count, chunkSize));
+    done.wait();
 }
 
-template <typename Ret, typename... Params>
-template <typename Obj, typename MemFunc>
-inline Connection<Ret(Params...)> Signal<Ret(Params...)>::connect(Obj* object, MemFunc&& memFunc)
+template <typename Ret, typename... Params, typename Policy>
+inline void Signal<Ret(Params...), Policy>::emitBatch(const BatchItem* items, std::size_t count)
+{
+    static_assert((std::is_same<ArgRef<Params>, const std::decay_t<Params>&>::value && ...),
+                  "Batches can only be emitted to slots taking values or const references");
+    if (count == 0u) {
+        return;
+    }
+    assert(_connections);
+    const auto connections = _connections->view();
+    const auto recorder = Instrument::recorder();
+    auto visited = std::size_t{0u};
+    connections.forEach([&visited, items, count](auto& connection) {
+        ++visited;
+        connection.callBatch(items, count);
+    });
+    recorder.recordEmits(count, visited * count);
+}
+
+template <typename Ret, typename... Params, typename Policy>
+template <typename Items>
+inline void Signal<Ret(Params...), Policy>::emitBatch(const Items& items)
 {
-    return connectBind(object, std::move(memFunc));
+    emitBatch(std::data(items), std::size(items));
 }
 
-template <typename Ret, typename... Params>
-inline Connection<Ret(Params...)> Signal<Ret(Params...)>::connect(Slot&& slot)
+template <typename Ret, typename... Params, typename Policy>
+template <typename Combiner>
+inline auto Signal<Ret(Params...), Policy>::emitCombined(Combiner combiner, ArgRef<Params>... args)
+    -> decltype(combiner.result())
 {
-    StateLock lock{_stateMutex};
-    return connectLocked(lock, std::move(slot));
+    static_assert(!std::is_void<Ret>::value, "Return values of void slots can not be combined");
+    assert(_connections);
+    const auto connections = _connections->view();
+    const auto recorder = Instrument::recorder();
+    auto visited = std::size_t{0u};
+    connections.forEach([&combiner, &visited, &args...](auto& connection) {
+        ++visited;
+        return connection.callCombined(combiner, std::forward<ArgRef<Params>>(args)...);
+    });
+    recorder.recordEmits(1u, visited);
+    return combiner.result();
 }
 
-template <typename Ret, typename... Params>
-inline bool Signal<Ret(Params...)>::disconnect(Connection<Ret(Params...)>& connection)
+template <typename Ret, typename... Params, typename Policy>
+inline const SignalMetrics& Signal<Ret(Params...), Policy>::metrics() const
 {
-    StateLock lock{_stateMutex};
-    return disconnectLocked(lock, connection);
+    static_assert(Policy::instrumented, "Metrics are only recorded by instrumented policies, see with_metrics");
+    return Instrument::metrics();
 }
 
-template <typename Ret, typename... Params>
-inline void Signal<Ret(Params...)>::disconnect()
+template <typename Ret, typename... Params, typename Policy>
+inline std::pmr::memory_resource* Signal<Ret(Params...), Policy>::resource() const
 {
-    StateLock lock{_stateMutex};
-    disconnectAllLocked(lock);
+    assert(_connections);
+    return _connections->resource();
 }
 
-template <typename Ret, typename... Params>
-template <typename Obj, typename MemFunc, std::size_t... Indices>
-inline Connection<Ret(Params...)> Signal<Ret(Params...)>::connectBind(Obj* object,
-                                                                      MemFunc Obj::*memFunc,
-                                                                      std::index_sequence<Indices...>)
+template <typename Ret, typename... Params, typename Policy>
+inline bool Signal<Ret(Params...), Policy>::empty() const
 {
-    return connect(std::bind(memFunc, object, PlaceholderTemplate<Indices>{}...));
+    assert(_connections);
+    auto empty = true;
+    _connections->view().forEach([&empty](const auto& connection) {
+        empty = !connection.valid();
+        return empty;
+    });
+    return empty;
 }
 
-template <typename Ret, typename... Params>
+template <typename Ret, typename... Params, typename Policy>
 template <typename Obj, typename MemFunc>
-inline Connection<Ret(Params...)> Signal<Ret(Params...)>::connectBind(Obj* object, MemFunc&& memFunc)
+inline Connection<Ret(Params...), Policy> Signal<Ret(Params...), Policy>::connect(Obj* object, MemFunc Obj::*memFunc)
 {
-    return connect([object, memFunc{std::move(memFunc)}](Params... params) { memFunc(object, params...); });
+    return track(object, connect(Slot{object, memFunc}));
 }
 
-template <typename Ret, typename... Params>
-inline bool Signal<Ret(Params...)>::disconnectLocked(const StateLock&, Connection<Ret(Params...)>& connection)
+template <typename Ret, typename... Params, typename Policy>
+template <typename Obj, typename MemFunc, typename>
+inline Connection<Ret(Params...), Policy> Signal<Ret(Params...), Policy>::connect(Obj* object, MemFunc&& memFunc)
 {
-    assert(_valid);
-    const auto I = std::find(std::begin(_connections), std::end(_connections), connection.sharedData());
-    if (I != std::end(_connections)) {
-        (*I)->invalidate();
-        _connections.erase(I);
-        return true;
+    return track(object, connectBind(object, std::move(memFunc)));
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline Connection<Ret(Params...), Policy> Signal<Ret(Params...), Policy>::connect(Slot&& slot)
+{
+    return connectData(
+        ConnectionData::buildConnection(_connections, std::move(slot), Policy::nextId(), 0, false));
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline Connection<Ret(Params...), Policy> Signal<Ret(Params...), Policy>::connect(Slot&& slot, int priority)
+{
+    static_assert(Connections::prioritized, "Priorities are not supported by this threading policy");
+    return connectData(
+        ConnectionData::buildConnection(_connections, std::move(slot), Policy::nextId(), priority, false));
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline Connection<Ret(Params...), Policy> Signal<Ret(Params...), Policy>::connectOnce(Slot&& slot)
+{
+    return connectData(ConnectionData::buildConnection(_connections, std::move(slot), Policy::nextId(), 0, true));
+}
+
+template <typename Ret, typename... Params, typename Policy>
+template <typename Executor>
+inline Connection<Ret(Params...), Policy> Signal<Ret(Params...), Policy>::connect(Slot&& slot, Executor& executor)
+{
+    static_assert(std::is_void<Ret>::value, "Queued slots can not return a value");
+    auto connection = ConnectionData::buildConnection(_connections, Slot{}, Policy::nextId(), 0, false);
+    connection->setSlot(
+        Slot{std::allocator_arg, resource(), QueuedSlot<Executor>{connection.get(), &executor, std::move(slot)}});
+    return connectData(std::move(connection));
+}
+
+template <typename Ret, typename... Params, typename Policy>
+template <typename Executor, typename Merge>
+inline Connection<Ret(Params...), Policy>
+Signal<Ret(Params...), Policy>::connectCoalesced(Slot&& slot, Executor& executor, Merge merge)
+{
+    static_assert(std::is_void<Ret>::value, "Coalesced slots can not return a value");
+    using Coalesced = CoalescedSlot<Executor, Merge>;
+    auto connection = ConnectionData::buildConnection(_connections, Slot{}, Policy::nextId(), 0, false);
+    auto pending = Policy::template makeShared<typename Coalesced::Pending>(resource());
+    connection->setSlot(Slot{
+        std::allocator_arg,
+        resource(),
+        Coalesced{connection.get(), &executor, std::move(slot), std::move(merge), std::move(pending)}});
+    return connectData(std::move(connection));
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline Connection<Ret(Params...), Policy> Signal<Ret(Params...), Policy>::connectBatch(BatchSlot&& slot)
+{
+    static_assert(std::is_void<Ret>::value, "Batch slots can not return a value");
+    return connect(
+        Slot{std::allocator_arg, resource(), typename Connection<SlotProto, Policy>::BatchAdapter{std::move(slot)}});
+}
+
+template <typename Ret, typename... Params, typename Policy>
+template <typename Executor>
+inline void Signal<Ret(Params...), Policy>::QueuedSlot<Executor>::operator()(ArgRef<Params>... args) const
+{
+    executor->post([connection = SharedConnectionData{connection},
+                    slot = &slot,
+                    args = std::make_tuple(std::decay_t<Params>(args)...)]() mutable {
+        if (connection->valid()) {
+            std::apply([slot](auto&... values) { slot->callMove(std::forward<Params>(values)...); }, args);
+        }
+    });
+}
+
+template <typename Ret, typename... Params, typename Policy>
+template <typename Executor, typename Merge>
+inline void Signal<Ret(Params...), Policy>::CoalescedSlot<Executor, Merge>::operator()(ArgRef<Params>... args)
+{
+    {
+        std::lock_guard<typename Policy::Mutex> lock{pending->mutex};
+        auto& values = pending->values;
+        if (!values) {
+            values.emplace(args...);
+        } else {
+            if constexpr (std::is_same<Merge, keep_latest>::value) {
+                *values = std::make_tuple(std::decay_t<Params>(args)...);
+            } else {
+                std::apply([this, &args...](auto&... previous) { merge(previous..., args...); }, *values);
+            }
+            return;
+        }
+    }
+    executor->post([connection = SharedConnectionData{connection}, slot = &slot, pending = pending.get()]() {
+        auto values = [pending]() {
+            std::lock_guard<typename Policy::Mutex> lock{pending->mutex};
+            return std::exchange(pending->values, std::nullopt);
+        }();
+        if (connection->valid()) {
+            std::apply([slot](auto&... values) { slot->callMove(std::forward<Params>(values)...); }, *values);
+        }
+    });
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline bool Signal<Ret(Params...), Policy>::disconnect(Connection<Ret(Params...), Policy>& connection)
+{
+    assert(_connections);
+    const auto data = connection.sharedData();
+    if (!data || data->connections() != _connections.get()) {
+        return false;
+    }
+    return _connections->disconnect(data);
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline void Signal<Ret(Params...), Policy>::disconnect()
+{
+    if (_connections) {
+        _connections->clear();
     }
-    return false;
 }
 
-template <typename Ret, typename... Params>
-inline Connection<Ret(Params...)> Signal<Ret(Params...)>::connectLocked(const StateLock&, Slot&& slot)
+template <typename Ret, typename... Params, typename Policy>
+template <typename Obj, typename MemFunc>
+inline Connection<Ret(Params...), Policy> Signal<Ret(Params...), Policy>::connectBind(Obj* object, MemFunc&& memFunc)
 {
-    assert(_valid);
-    static std::atomic<uint64_t> id{0u};
-    auto connection = ConnectionData::buildConnection(this, std::move(slot), id++);
-    _connections.push_back(connection);
-    return {connection};
+    return connect(Slot{std::allocator_arg, resource(), [object, memFunc{std::move(memFunc)}](ArgRef<Params>... params) {
+                            std::invoke(memFunc, object, params...);
+                        }});
 }
 
-template <typename Ret, typename... Params>
-inline void Signal<Ret(Params...)>::disconnectAllLocked(const StateLock& lock)
+template <typename Ret, typename... Params, typename Policy>
+template <typename Obj>
+inline Connection<Ret(Params...), Policy> Signal<Ret(Params...), Policy>::track(Obj* object,
+                                                                               Connection<SlotProto, Policy> connection)
 {
-    forEachConnection(lock, [](auto& connection) { connection.invalidate(); });
-    _connections.clear();
+    if constexpr (std::is_base_of<Trackable, Obj>::value) {
+        /// Tracking is bookkeeping, not state of the receiver, so const receivers are tracked as well
+        const_cast<std::remove_const_t<Obj>*>(object)->Trackable::track(connection);
+    }
+    return connection;
 }
 
-template <typename Ret, typename... Params>
-inline void Signal<Ret(Params...)>::forEachConnection(const StateLock&, std::function<void(ConnectionData&)>&& func)
+template <typename Ret, typename... Params, typename Policy>
+inline Connection<Ret(Params...), Policy> Signal<Ret(Params...), Policy>::connectData(SharedConnectionData connection)
 {
-    for (auto I = std::rbegin(_connections); I != std::rend(_connections); ++I) {
-        func(**I);
+    assert(_connections);
+    if constexpr (Policy::instrumented) {
+        connection->setMetrics(Instrument::metrics().addSlot(connection->id()));
     }
+    _connections->connect(connection);
+    return {std::move(connection)};
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline auto Signal<Ret(Params...), Policy>::makeConnections(std::pmr::memory_resource* resource) -> ConnectionsPtr
+{
+    return Policy::template makeShared<Connections>(resource, resource);
 }
 
 /// ]]] Signal ----------------------------------------------------------------
@@ -266,13 +691,18 @@ inline void Signal<Ret(Params...)>::forEachConnection(const StateLock&, std::fun
 /// [[[ Connection ------------------------------------------------------------
 
 /// A connection class that references a signal-slot connection.
-template <typename Ret, typename... Params>
-class Connection<Ret(Params...)> {
+template <typename Ret, typename... Params, typename Policy>
+class Connection<Ret(Params...), Policy> {
 public:
     using SlotProto = Ret(Params...);
-    using Slot = std::function<SlotProto>;
+    using Slot = Delegate<SlotProto>;
 
+    /// Construct an empty connection, which is never valid.
+    Connection() = default;
+
+    /// Connections are equal if they refer to the same connection, or are both empty.
     bool operator==(const Connection&) const;
+    bool operator!=(const Connection&) const;
 
     /// Disconnect this connection from the signal.
     /// @returns True if the connection was disconnect, false otherwise.
@@ -283,83 +713,111 @@ public:
     bool valid() const;
 
 private:
-    friend class Signal<SlotProto>;
+    friend class Signal<SlotProto, Policy>;
     class ConnectionData;
 
+    using BatchItem = std::tuple<std::decay_t<Params>...>;
+    using BatchSlot = Delegate<void(const BatchItem*, std::size_t)>;
+
+    /// The slot of a connection made with Signal::connectBatch.
+    /// @note Called directly when emitting a batch, only called as a slot when emitting a single item.
+    struct BatchAdapter {
+        void operator()(ArgRef<Params>... args) const;
+
+        BatchSlot slot;
+    };
+
+    /// The store of the signal a connection belongs to.
+    using Connections = typename Policy::template Connections<IntrusivePtr<ConnectionData>>;
+    /// Held by the signal and each of its connections.
+    using SharedConnections = typename Policy::template SharedPtr<Connections>;
+
     /// Construct a connection from scratch
-    Connection(Signal<SlotProto>* signal, Slot&& slot, uint32_t id);
+    Connection(const SharedConnections& connections, Slot&& slot, ConnectionId id);
 
     /// Construct a connection from shared data
-    Connection(std::shared_ptr<ConnectionData> sharedConnectionData);
+    Connection(IntrusivePtr<ConnectionData> sharedConnectionData);
 
     /// Call the slot.
-    template <typename... Args>
-    void call(Args... args);
+    void call(ArgRef<Params>... args);
 
     /// Invalidate the connection.
     void invalidate();
 
     /// Get the connection id.
-    uint32_t id() const;
+    ConnectionId id() const;
 
     /// Get the shared data.
-    const std::shared_ptr<ConnectionData> sharedData() const;
+    const IntrusivePtr<ConnectionData> sharedData() const;
 
-    std::shared_ptr<ConnectionData> _sharedConnectionData;
+    IntrusivePtr<ConnectionData> _sharedConnectionData;
 };
 
-template <typename Ret, typename... Params>
-inline bool Connection<Ret(Params...)>::operator==(const Connection& other) const
+template <typename Ret, typename... Params, typename Policy>
+inline void Connection<Ret(Params...), Policy>::BatchAdapter::operator()(ArgRef<Params>... args) const
 {
-    return id() == other.id();
+    const auto item = BatchItem{args...};
+    slot(&item, 1u);
 }
 
-template <typename Ret, typename... Params>
-inline bool Connection<Ret(Params...)>::disconnect()
+template <typename Ret, typename... Params, typename Policy>
+inline bool Connection<Ret(Params...), Policy>::operator==(const Connection& other) const
 {
-    return _sharedConnectionData->disconnect();
+    return _sharedConnectionData == other._sharedConnectionData;
 }
 
-template <typename Ret, typename... Params>
-inline bool Connection<Ret(Params...)>::valid() const
+template <typename Ret, typename... Params, typename Policy>
+inline bool Connection<Ret(Params...), Policy>::operator!=(const Connection& other) const
 {
-    return _sharedConnectionData->valid();
+    return !(*this == other);
 }
 
-template <typename Ret, typename... Params>
-inline Connection<Ret(Params...)>::Connection(Signal<SlotProto>* signal, Slot&& slot, uint32_t id)
-: _sharedConnectionData{ConnectionData::buildConnection(signal, std::move(slot), id)}
+template <typename Ret, typename... Params, typename Policy>
+inline bool Connection<Ret(Params...), Policy>::disconnect()
 {
+    return _sharedConnectionData && _sharedConnectionData->disconnect();
 }
 
-template <typename Ret, typename... Params>
-inline Connection<Ret(Params...)>::Connection(std::shared_ptr<ConnectionData> sharedConnectionData)
+template <typename Ret, typename... Params, typename Policy>
+inline bool Connection<Ret(Params...), Policy>::valid() const
+{
+    return _sharedConnectionData && _sharedConnectionData->valid();
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline Connection<Ret(Params...), Policy>::Connection(const SharedConnections& connections,
+                                                      Slot&& slot,
+                                                      ConnectionId id)
+: _sharedConnectionData{ConnectionData::buildConnection(connections, std::move(slot), id, 0, false)}
+{
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline Connection<Ret(Params...), Policy>::Connection(IntrusivePtr<ConnectionData> sharedConnectionData)
 : _sharedConnectionData{std::move(sharedConnectionData)}
 {
 }
 
-template <typename Ret, typename... Params>
-template <typename... Args>
-inline void Connection<Ret(Params...)>::call(Args... args)
+template <typename Ret, typename... Params, typename Policy>
+inline void Connection<Ret(Params...), Policy>::call(ArgRef<Params>... args)
 {
-    _sharedConnectionData->call(std::forward<Args>(args)...);
+    _sharedConnectionData->call(std::forward<ArgRef<Params>>(args)...);
 }
 
-template <typename Ret, typename... Params>
-inline void Connection<Ret(Params...)>::invalidate()
+template <typename Ret, typename... Params, typename Policy>
+inline void Connection<Ret(Params...), Policy>::invalidate()
 {
     _sharedConnectionData->invalidate();
 }
 
-template <typename Ret, typename... Params>
-inline uint32_t Connection<Ret(Params...)>::id() const
+template <typename Ret, typename... Params, typename Policy>
+inline ConnectionId Connection<Ret(Params...), Policy>::id() const
 {
     return _sharedConnectionData->id();
 }
 
-template <typename Ret, typename... Params>
-inline const std::shared_ptr<typename Connection<Ret(Params...)>::ConnectionData> Connection<
-    Ret(Params...)>::sharedData() const
+template <typename Ret, typename... Params, typename Policy>
+inline auto Connection<Ret(Params...), Policy>::sharedData() const -> const IntrusivePtr<ConnectionData>
 {
     return _sharedConnectionData;
 }
@@ -369,11 +827,14 @@ inline const std::shared_ptr<typename Connection<Ret(Params...)>::ConnectionData
 /// [[[ Connection::ConnectionData --------------------------------------
 
 /// Class containing data shared between equivalint connections
-template <typename Ret, typename... Params>
-class Connection<Ret(Params...)>::ConnectionData : public std::enable_shared_from_this<ConnectionData> {
+/// @note Times slot calls with an instrumented policy.
+template <typename Ret, typename... Params, typename Policy>
+class Connection<Ret(Params...), Policy>::ConnectionData : public SlotInstrument<Policy::instrumented> {
 public:
-    /// Connection data should only be held as a shared_ptr (due to the use of shared_from_this)
-    static std::shared_ptr<ConnectionData> buildConnection(Signal<SlotProto>* signal, Slot&& slot, uint32_t id);
+    /// Connection data should only be held through an IntrusivePtr.
+    /// @param once Disconnect the connection before its slot is first called, see Signal::connectOnce.
+    static IntrusivePtr<ConnectionData>
+    buildConnection(const SharedConnections& connections, Slot&& slot, ConnectionId id, int priority, bool once);
 
     /// Non-copyable / Non-movable
     ConnectionData(const ConnectionData&) = delete;
@@ -381,98 +842,231 @@ public:
     ConnectionData& operator=(const ConnectionData&) = delete;
     ConnectionData& operator=(ConnectionData&&) = delete;
 
-    /// Call the slot.
-    template <typename... Args>
-    void call(Args... args);
+    /// Call the slot if the connection is still valid.
+    /// @note A slot may disconnect itself while it runs.
+    void call(ArgRef<Params>... args);
+
+    /// Call the slot if the connection is still valid, moving @p args into it.
+    void callMove(Params&&... args);
+
+    /// Call the slot with each of @p items while the connection is valid.
+    void callBatch(const BatchItem* items, std::size_t count);
+
+    /// Call the slot if the connection is still valid, passing the value it returns to @p combiner.
+    /// @returns False if @p combiner asked to stop, true otherwise.
+    template <typename Combiner>
+    bool callCombined(Combiner& combiner, ArgRef<Params>... args);
 
     /// Get the validity of the connection.
     bool valid() const;
 
     /// Invalidate the connection.
-    void invalidate();
+    /// @returns True if the connection was valid, false otherwise.
+    bool invalidate();
 
     /// Get the id of the connection.
-    uint32_t id() const;
+    ConnectionId id() const;
+
+    /// Get the priority of the connection.
+    int priority() const;
+
+    /// Get the store of the signal the connection belongs to.
+    /// @note Kept alive by the connection, so it may be used while the signal is destroyed.
+    Connections* connections() const;
 
     /// Disconnect from the signal.
     bool disconnect();
 
-    /// Update the signal in the event that it has moved.
-    void updateSignal(Signal<SlotProto>* signal);
+    /// Replace the slot.
+    /// @note Only valid before the connection is connected to the signal.
+    void setSlot(Slot&& slot);
 
-private:
-    using StateLock = std::lock_guard<std::mutex>;
+    /// Take a reference to the connection data.
+    void retain();
 
-    ConnectionData(Signal<SlotProto>* signal, Slot&& slot, uint32_t id);
+    /// Release a reference to the connection data, destroying it if it was the last one.
+    void release();
 
-    mutable std::mutex _stateMutex;
-    Signal<SlotProto>* _signal;
-    bool _valid{true};
+private:
+    ConnectionData(const SharedConnections& connections, Slot&& slot, ConnectionId id, int priority, bool once);
+
+    /// Check whether the slot may be called.
+    /// @note A connection made with connectOnce is disconnected by the first caller, so exactly one call goes through
+    /// even if several threads emit at once.
+    /// @returns True if the slot may be called, false otherwise.
+    bool claim();
+
+    /// Read by every emission, kept together at the front so a slot call touches as few cache lines as possible.
+    /// Checked once per slot per emit, released by invalidate.
+    typename Policy::template Atomic<bool> _valid{true};
+    const bool _once;
     Slot _slot;
-    uint32_t _id;
+    /// Only read when connecting, disconnecting and releasing.
+    typename Policy::template Atomic<uint32_t> _refCount{0u};
+    /// The resource this was allocated from, the connections may be gone by the time it is freed.
+    std::pmr::memory_resource* const _resource;
+    const ConnectionId _id;
+    const int _priority;
+    /// Only released with the connection data, the store in turn drops the connection data when it is cleared.
+    const SharedConnections _connections;
 };
 
-template <typename Ret, typename... Params>
-inline auto Connection<Ret(Params...)>::ConnectionData::buildConnection(Signal<SlotProto>* signal,
-                                                                        Slot&& slot,
-                                                                        uint32_t id) -> std::shared_ptr<ConnectionData>
+template <typename Ret, typename... Params, typename Policy>
+inline auto
+Connection<Ret(Params...), Policy>::ConnectionData::buildConnection(const SharedConnections& connections,
+                                                                    Slot&& slot,
+                                                                    ConnectionId id,
+                                                                    int priority,
+                                                                    bool once) -> IntrusivePtr<ConnectionData>
 {
-    /// Can't use make_shared as the construtor is private. May convert to the struct work around in the future.
-    return std::shared_ptr<ConnectionData>(new ConnectionData(signal, std::move(slot), id));
+    /// The reference count lives in the connection data, so this is the only allocation.
+    const auto memory = allocate(connections->resource(), sizeof(ConnectionData), alignof(ConnectionData));
+    return IntrusivePtr<ConnectionData>{new (memory) ConnectionData(connections, std::move(slot), id, priority, once)};
 }
 
-template <typename Ret, typename... Params>
-inline Connection<Ret(Params...)>::ConnectionData::ConnectionData(Signal<SlotProto>* signal, Slot&& slot, uint32_t id)
-: _signal{signal}
+template <typename Ret, typename... Params, typename Policy>
+inline Connection<Ret(Params...), Policy>::ConnectionData::ConnectionData(const SharedConnections& connections,
+                                                                          Slot&& slot,
+                                                                          ConnectionId id,
+                                                                          int priority,
+                                                                          bool once)
+: _once{once}
 , _slot{std::move(slot)}
+, _resource{connections->resource()}
 , _id{id}
+, _priority{priority}
+, _connections{connections}
+{
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline void Connection<Ret(Params...), Policy>::ConnectionData::call(ArgRef<Params>... args)
+{
+    /// The emitting snapshot may still hold connections that were disconnected after it was taken.
+    if (claim()) {
+        [[maybe_unused]] const auto timer = this->time();
+        _slot(std::forward<ArgRef<Params>>(args)...);
+    }
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline void Connection<Ret(Params...), Policy>::ConnectionData::callMove(Params&&... args)
 {
+    if (claim()) {
+        [[maybe_unused]] const auto timer = this->time();
+        _slot.callMove(std::forward<Params>(args)...);
+    }
 }
 
-template <typename Ret, typename... Params>
-template <typename... Args>
-inline void Connection<Ret(Params...)>::ConnectionData::call(Args... args)
+template <typename Ret, typename... Params, typename Policy>
+inline void Connection<Ret(Params...), Policy>::ConnectionData::callBatch(const BatchItem* items, std::size_t count)
 {
-    StateLock lock{_stateMutex};
-    assert(_valid);
-    _slot(std::forward<Args>(args)...);
+    if (const auto adapter = _slot.template target<BatchAdapter>()) {
+        if (valid()) {
+            [[maybe_unused]] const auto timer = this->time();
+            adapter->slot(items, count);
+        }
+        return;
+    }
+    /// A slot may disconnect itself part way through the batch
+    for (auto I = items; I != items + count && claim(); ++I) {
+        [[maybe_unused]] const auto timer = this->time();
+        std::apply([this](const auto&... args) { _slot(args...); }, *I);
+    }
 }
 
-template <typename Ret, typename... Params>
-inline bool Connection<Ret(Params...)>::ConnectionData::valid() const
+template <typename Ret, typename... Params, typename Policy>
+template <typename Combiner>
+inline bool Connection<Ret(Params...), Policy>::ConnectionData::callCombined(Combiner& combiner, ArgRef<Params>... args)
 {
-    StateLock lock{_stateMutex};
-    return _valid;
+    if (!claim()) {
+        return true;
+    }
+    if constexpr (Policy::instrumented) {
+        auto value = [this, &args...]() {
+            [[maybe_unused]] const auto timer = this->time();
+            return _slot(std::forward<ArgRef<Params>>(args)...);
+        }();
+        return combiner(std::move(value));
+    } else {
+        return combiner(_slot(std::forward<ArgRef<Params>>(args)...));
+    }
 }
 
-template <typename Ret, typename... Params>
-inline void Connection<Ret(Params...)>::ConnectionData::invalidate()
+template <typename Ret, typename... Params, typename Policy>
+inline bool Connection<Ret(Params...), Policy>::ConnectionData::claim()
 {
-    StateLock lock{_stateMutex};
-    _valid = false;
+    /// Disconnecting through the signal keeps its count of dead connections right, only one caller gets true
+    return valid() && (!_once || disconnect());
 }
 
-template <typename Ret, typename... Params>
-inline uint32_t Connection<Ret(Params...)>::ConnectionData::id() const
+template <typename Ret, typename... Params, typename Policy>
+inline bool Connection<Ret(Params...), Policy>::ConnectionData::valid() const
+{
+    return _valid.load(std::memory_order_acquire);
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline bool Connection<Ret(Params...), Policy>::ConnectionData::invalidate()
+{
+    return _valid.exchange(false, std::memory_order_acq_rel);
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline ConnectionId Connection<Ret(Params...), Policy>::ConnectionData::id() const
 {
-    StateLock lock{_stateMutex};
     return _id;
 }
 
-template <typename Ret, typename... Params>
-inline void Connection<Ret(Params...)>::ConnectionData::updateSignal(Signal<SlotProto>* signal)
+template <typename Ret, typename... Params, typename Policy>
+inline int Connection<Ret(Params...), Policy>::ConnectionData::priority() const
+{
+    return _priority;
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline auto Connection<Ret(Params...), Policy>::ConnectionData::connections() const -> Connections*
 {
-    StateLock lock{_stateMutex};
-    _signal = signal;
+    return _connections.get();
 }
 
-template <typename Ret, typename... Params>
-inline bool Connection<Ret(Params...)>::ConnectionData::disconnect()
+template <typename Ret, typename... Params, typename Policy>
+inline void Connection<Ret(Params...), Policy>::ConnectionData::setSlot(Slot&& slot)
 {
-    auto connection = Connection{this->shared_from_this()};
-    return _signal->disconnect(connection);
+    _slot = std::move(slot);
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline bool Connection<Ret(Params...), Policy>::ConnectionData::disconnect()
+{
+    /// Once invalid there is nothing to remove, e.g. a connection outliving its signal
+    if (!valid()) {
+        return false;
+    }
+    /// The caller holds a reference, so no temporary one is taken to keep this alive
+    return _connections->disconnect(this);
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline void Connection<Ret(Params...), Policy>::ConnectionData::retain()
+{
+    _refCount.fetch_add(1u, std::memory_order_relaxed);
+}
+
+template <typename Ret, typename... Params, typename Policy>
+inline void Connection<Ret(Params...), Policy>::ConnectionData::release()
+{
+    /// Read before deleting, the count is part of the deleted object
+    const auto remaining = _refCount.fetch_sub(1u, std::memory_order_acq_rel) - 1u;
+    if (remaining == 0u) {
+        deleteObject(_resource, this);
+    }
 }
 
 /// ]]] Connection::ConnectionData --------------------------------------
 
 } // namespace moment
+
+#if MOMENT_COROUTINES
+#include <moment/Awaitable.hpp>
+#endif
@@ -0,0 +1,342 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory_resource>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <moment/MemoryResource.hpp>
+#include <moment/Signal.hpp>
+
+namespace moment {
+
+/// Generic template declaration. SignalMap is a template specialization to allow for SignalMap<Key, void(int)>
+template <typename Key,
+          typename,
+          typename Policy = multi_threaded,
+          typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class SignalMap;
+
+/// [[[ SignalMap -------------------------------------------------------------
+
+/// A signal per key, slots connect to one key and emitting a key only calls the slots connected to it.
+/// @note Each key is a Signal, so connections behave exactly as they do on a signal. Keys are found in a flat, open
+/// addressed index that emitters read without locking or reference counting, connecting to a new key fills the index
+/// in place and only copies it when it grows. Outgrown indexes are kept until the map is destroyed, as they double
+/// in size that is less memory than the current index.
+/// @note Slots connected with connectAll are called for every key, after the slots of the key.
+/// @note Each key is a signal of its own, with its own connection store and lock, keys only share the memory resource
+/// of the map. Pass a pool resource to share storage between keys.
+/// @note A key keeps its entry once connected to, even when all of its connections are gone, until compact removes
+/// it.
+template <typename Key, typename... Params, typename Policy, typename Hash, typename KeyEqual>
+class SignalMap<Key, void(Params...), Policy, Hash, KeyEqual> {
+public:
+    using SlotProto = void(Params...);
+    using Slot = Delegate<SlotProto>;
+    /// Slots connected to every key are passed the key emitted.
+    using WildcardProto = void(const Key&, Params...);
+    using WildcardSlot = Delegate<WildcardProto>;
+
+    /// @param resource The resource the signals allocate from, see Signal.
+    explicit SignalMap(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    ~SignalMap();
+
+    /// Non-copyable / Non-movable
+    SignalMap(const SignalMap&) = delete;
+    SignalMap(SignalMap&&) = delete;
+    SignalMap& operator=(const SignalMap&) = delete;
+    SignalMap& operator=(SignalMap&&) = delete;
+
+    /// Connect a slot to one key.
+    /// @param key The key the slot is called for.
+    /// @param slot The slot to connect.
+    /// @returns The connection created.
+    Connection<SlotProto, Policy> connect(const Key& key, Slot&& slot);
+
+    /// Connect a slot to every key.
+    /// @param slot The slot to connect, called with the key emitted.
+    /// @returns The connection created.
+    Connection<WildcardProto, Policy> connectAll(WildcardSlot&& slot);
+
+    /// Emit a key.
+    /// @see emit
+    void operator()(const Key& key, ArgRef<Params>... args);
+
+    /// Emit a key, calling the slots connected to it and then those connected to every key.
+    /// @note Finding the key is O(1) and never locks.
+    void emit(const Key& key, ArgRef<Params>... args);
+
+    /// Remove the keys no slot is connected to any more.
+    /// @note Emitters find keys without synchronizing with their removal, so the map must not be emitted from
+    /// another thread meanwhile. A slot of the map may call it.
+    /// @returns The number of keys removed.
+    std::size_t compact();
+
+    /// Get the number of keys that were connected to and not removed by compact.
+    std::size_t size() const;
+
+private:
+    /// A key and its signal, never moved once made.
+    struct Topic {
+        Topic(std::pmr::memory_resource* resource, const Key& key);
+
+        const Key key;
+        Signal<SlotProto, Policy> signal;
+    };
+
+    /// A fixed capacity, open addressed table of topics that is only ever added to.
+    /// @note An entry is published by storing its topic, so an emitter can probe the table while a key is added.
+    class Index {
+    public:
+        Index(std::pmr::memory_resource* resource, std::size_t capacity);
+        ~Index();
+
+        /// Non-copyable / Non-movable
+        Index(const Index&) = delete;
+        Index(Index&&) = delete;
+        Index& operator=(const Index&) = delete;
+        Index& operator=(Index&&) = delete;
+
+        /// @returns The topic of @p key, null if there is none.
+        Topic* find(std::size_t hash, const Key& key, const KeyEqual& keyEqual) const;
+
+        /// Add a topic, its key must not be in the table yet.
+        /// @note Inserts must be serialized and leave at least one entry empty.
+        void insert(std::size_t hash, Topic* topic);
+
+        std::size_t capacity() const;
+
+    private:
+        struct Entry {
+            /// Set once, the hash is written first.
+            typename Policy::template Atomic<Topic*> topic{nullptr};
+            std::size_t hash{0u};
+        };
+
+        std::pmr::memory_resource* const _resource;
+        /// A power of two.
+        const std::size_t _capacity;
+        Entry* const _entries;
+    };
+
+    using StateLock = std::lock_guard<typename Policy::Mutex>;
+
+    /// Find the topic of @p key, making it if there is none.
+    Topic& topicLocked(const StateLock& lock, const Key& key);
+    /// Publish a new index of @p capacity entries holding every topic.
+    void rehashLocked(const StateLock& lock, std::size_t capacity);
+
+    std::pmr::memory_resource* const _resource;
+    Hash _hash;
+    KeyEqual _keyEqual;
+    Signal<WildcardProto, Policy> _wildcard;
+    /// Set once a slot connected to every key, so emitting skips the wildcard signal until then.
+    typename Policy::template Atomic<bool> _hasWildcard{false};
+    /// Serializes adding keys, never held while emitting.
+    mutable typename Policy::Mutex _stateMutex;
+    /// The current index, null until a key is added.
+    typename Policy::template Atomic<Index*> _index{nullptr};
+    /// Every index since the last compact and every topic, guarded by _stateMutex.
+    std::vector<Index*> _indexes;
+    std::vector<Topic*> _topics;
+};
+
+template <typename Key, typename... Params, typename Policy, typename Hash, typename KeyEqual>
+inline SignalMap<Key, void(Params...), Policy, Hash, KeyEqual>::SignalMap(std::pmr::memory_resource* resource)
+: _resource{resource}
+, _wildcard{resource}
+{
+}
+
+template <typename Key, typename... Params, typename Policy, typename Hash, typename KeyEqual>
+inline SignalMap<Key, void(Params...), Policy, Hash, KeyEqual>::~SignalMap()
+{
+    for (const auto topic : _topics) {
+        deleteObject(_resource, topic);
+    }
+    for (const auto index : _indexes) {
+        deleteObject(_resource, index);
+    }
+}
+
+template <typename Key, typename... Params, typename Policy, typename Hash, typename KeyEqual>
+inline auto SignalMap<Key, void(Params...), Policy, Hash, KeyEqual>::connect(const Key& key, Slot&& slot)
+    -> Connection<SlotProto, Policy>
+{
+    /// Connected under the lock, so compact can not remove the topic in between
+    StateLock lock{_stateMutex};
+    return topicLocked(lock, key).signal.connect(std::move(slot));
+}
+
+template <typename Key, typename... Params, typename Policy, typename Hash, typename KeyEqual>
+inline auto SignalMap<Key, void(Params...), Policy, Hash, KeyEqual>::connectAll(WildcardSlot&& slot)
+    -> Connection<WildcardProto, Policy>
+{
+    auto connection = _wildcard.connect(std::move(slot));
+    _hasWildcard.store(true, std::memory_order_release);
+    return connection;
+}
+
+template <typename Key, typename... Params, typename Policy, typename Hash, typename KeyEqual>
+inline void SignalMap<Key, void(Params...), Policy, Hash, KeyEqual>::operator()(const Key& key, ArgRef<Params>... args)
+{
+    emit(key, std::forward<ArgRef<Params>>(args)...);
+}
+
+template <typename Key, typename... Params, typename Policy, typename Hash, typename KeyEqual>
+inline void SignalMap<Key, void(Params...), Policy, Hash, KeyEqual>::emit(const Key& key, ArgRef<Params>... args)
+{
+    if (const auto index = _index.load(std::memory_order_acquire)) {
+        if (const auto topic = index->find(_hash(key), key, _keyEqual)) {
+            topic->signal.emit(std::forward<ArgRef<Params>>(args)...);
+        }
+    }
+    if (_hasWildcard.load(std::memory_order_acquire)) {
+        _wildcard.emit(key, std::forward<ArgRef<Params>>(args)...);
+    }
+}
+
+template <typename Key, typename... Params, typename Policy, typename Hash, typename KeyEqual>
+inline std::size_t SignalMap<Key, void(Params...), Policy, Hash, KeyEqual>::compact()
+{
+    StateLock lock{_stateMutex};
+    const auto live = std::partition(_topics.begin(), _topics.end(), [](const Topic* topic) {
+        return !topic->signal.empty();
+    });
+    const auto removed = static_cast<std::size_t>(_topics.end() - live);
+    if (removed == 0u) {
+        return 0u;
+    }
+    auto emptied = std::vector<Topic*>{live, _topics.end()};
+    _topics.erase(live, _topics.end());
+    /// Shrunk to the smallest capacity that keeps the index at most half full
+    auto capacity = std::size_t{16u};
+    while (2u * _topics.size() > capacity) {
+        capacity *= 2u;
+    }
+    const auto indexes = std::move(_indexes);
+    _indexes.clear();
+    if (_topics.empty()) {
+        _index.store(nullptr, std::memory_order_release);
+    } else {
+        rehashLocked(lock, capacity);
+    }
+    for (const auto index : indexes) {
+        deleteObject(_resource, index);
+    }
+    /// A slot may be running in one of them, destroying a signal from its own slot is safe
+    for (const auto topic : emptied) {
+        deleteObject(_resource, topic);
+    }
+    return removed;
+}
+
+template <typename Key, typename... Params, typename Policy, typename Hash, typename KeyEqual>
+inline std::size_t SignalMap<Key, void(Params...), Policy, Hash, KeyEqual>::size() const
+{
+    StateLock lock{_stateMutex};
+    return _topics.size();
+}
+
+template <typename Key, typename... Params, typename Policy, typename Hash, typename KeyEqual>
+inline auto SignalMap<Key, void(Params...), Policy, Hash, KeyEqual>::topicLocked(const StateLock& lock,
+                                                                                   const Key& key) -> Topic&
+{
+    const auto hash = _hash(key);
+    const auto index = _index.load(std::memory_order_relaxed);
+    if (index) {
+        if (const auto topic = index->find(hash, key, _keyEqual)) {
+            return *topic;
+        }
+    }
+    const auto topic = newObject<Topic>(_resource, _resource, key);
+    _topics.push_back(topic);
+    /// Kept at most half full so probes stay short, grown by rehashing every topic into a table twice the size
+    if (!index || 2u * _topics.size() > index->capacity()) {
+        rehashLocked(lock, index ? 2u * index->capacity() : 16u);
+    } else {
+        index->insert(hash, topic);
+    }
+    return *topic;
+}
+
+template <typename Key, typename... Params, typename Policy, typename Hash, typename KeyEqual>
+inline void SignalMap<Key, void(Params...), Policy, Hash, KeyEqual>::rehashLocked(const StateLock&,
+                                                                                   std::size_t capacity)
+{
+    const auto index = newObject<Index>(_resource, _resource, capacity);
+    _indexes.push_back(index);
+    for (const auto topic : _topics) {
+        index->insert(_hash(topic->key), topic);
+    }
+    _index.store(index, std::memory_order_release);
+}
+
+template <typename Key, typename... Params, typename Policy, typename Hash, typename KeyEqual>
+inline SignalMap<Key, void(Params...), Policy, Hash, KeyEqual>::Topic::Topic(std::pmr::memory_resource* resource,
+                                                                              const Key& key)
+: key{key}
+, signal{resource}
+{
+}
+
+template <typename Key, typename... Params, typename Policy, typename Hash, typename KeyEqual>
+inline SignalMap<Key, void(Params...), Policy, Hash, KeyEqual>::Index::Index(std::pmr::memory_resource* resource,
+                                                                              std::size_t capacity)
+: _resource{resource}
+, _capacity{capacity}
+, _entries{newArray<Entry>(resource, capacity)}
+{
+}
+
+template <typename Key, typename... Params, typename Policy, typename Hash, typename KeyEqual>
+inline SignalMap<Key, void(Params...), Policy, Hash, KeyEqual>::Index::~Index()
+{
+    deleteArray(_resource, _entries, _capacity);
+}
+
+template <typename Key, typename... Params, typename Policy, typename Hash, typename KeyEqual>
+inline auto SignalMap<Key, void(Params...), Policy, Hash, KeyEqual>::Index::find(std::size_t hash,
+                                                                                  const Key& key,
+                                                                                  const KeyEqual& keyEqual) const
+    -> Topic*
+{
+    const auto mask = _capacity - 1u;
+    for (auto I = hash & mask;; I = (I + 1u) & mask) {
+        const auto& entry = _entries[I];
+        const auto topic = entry.topic.load(std::memory_order_acquire);
+        if (!topic) {
+            return nullptr;
+        }
+        if (entry.hash == hash && keyEqual(topic->key, key)) {
+            return topic;
+        }
+    }
+}
+
+template <typename Key, typename... Params, typename Policy, typename Hash, typename KeyEqual>
+inline void SignalMap<Key, void(Params...), Policy, Hash, KeyEqual>::Index::insert(std::size_t hash, Topic* topic)
+{
+    const auto mask = _capacity - 1u;
+    auto I = hash & mask;
+    while (_entries[I].topic.load(std::memory_order_relaxed)) {
+        I = (I + 1u) & mask;
+    }
+    _entries[I].hash = hash;
+    _entries[I].topic.store(topic, std::memory_order_release);
+}
+
+template <typename Key, typename... Params, typename Policy, typename Hash, typename KeyEqual>
+inline std::size_t SignalMap<Key, void(Params...), Policy, Hash, KeyEqual>::Index::capacity() const
+{
+    return _capacity;
+}
+
+/// ]]] SignalMap -------------------------------------------------------------
+
+} // namespace moment
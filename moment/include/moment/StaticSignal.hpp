@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <moment/Combiners.hpp>
+#include <moment/Delegate.hpp>
+
+namespace moment {
+
+/// Generic template declarations. StaticSignal is a template specialization to allow for StaticSignal<void(int), ...>
+
+template <auto Func, typename = decltype(Func)>
+struct StaticSlot;
+
+template <typename, typename... Slots>
+class StaticSignal;
+
+/// [[[ StaticSlot ------------------------------------------------------------
+
+/// A callable for a function known at compile time, the call is direct and can be inlined.
+/// @note Free functions need no state, StaticSlot<&func>{}.
+template <auto Func, typename FuncType>
+struct StaticSlot {
+    template <typename... Args>
+    decltype(auto) operator()(Args&&... args) const
+    {
+        return Func(std::forward<Args>(args)...);
+    }
+};
+
+/// A callable for a member function known at compile time, only the object is stored.
+/// @note StaticSlot<&Obj::func>{&object}.
+template <auto Func, typename Obj, typename MemFunc>
+struct StaticSlot<Func, MemFunc Obj::*> {
+    template <typename... Args>
+    decltype(auto) operator()(Args&&... args) const
+    {
+        return (object->*Func)(std::forward<Args>(args)...);
+    }
+
+    Obj* object;
+};
+
+/// ]]] StaticSlot ------------------------------------------------------------
+
+/// [[[ StaticSignal ----------------------------------------------------------
+
+/// A signal whose slots are fixed at compile time.
+/// @note Slots are stored by value and called directly in the order they are listed, there is no type erasure,
+/// allocation or synchronization. Emitting mirrors Signal so the two can be swapped by changing the type: return
+/// values are ignored except for Handled, which stops at the first slot that returns Handled::Yes.
+/// @tparam Slots The callable types, e.g. StaticSlot or lambdas, see makeStaticSignal.
+template <typename Ret, typename... Params, typename... Slots>
+class StaticSignal<Ret(Params...), Slots...> {
+    static_assert((std::is_invocable_r<Ret, Slots&, ArgRef<Params>...>::value && ...),
+                  "Every slot must be callable with the parameters of the signal");
+
+public:
+    using SlotProto = Ret(Params...);
+    /// The value returned by emit.
+    using EmitResult = std::conditional_t<std::is_same<Ret, Handled>::value, Handled, void>;
+
+    /// Construct the signal from its slots.
+    explicit StaticSignal(Slots... slots);
+
+    /// Emit the signal.
+    /// @see emit
+    EmitResult operator()(ArgRef<Params>... args);
+
+    /// Emit the signal, calling every slot in order.
+    /// @returns Handled::Yes if a slot handled the emission, for signals returning Handled.
+    EmitResult emit(ArgRef<Params>... args);
+
+    /// Emit the signal, passing the value returned by each slot to @p combiner.
+    /// @note Stops once @p combiner returns false.
+    /// @returns The combined result.
+    template <typename Combiner>
+    auto emitCombined(Combiner combiner, ArgRef<Params>... args) -> decltype(combiner.result());
+
+    /// Get the number of slots.
+    static constexpr std::size_t size();
+
+private:
+    std::tuple<Slots...> _slots;
+};
+
+template <typename Ret, typename... Params, typename... Slots>
+inline StaticSignal<Ret(Params...), Slots...>::StaticSignal(Slots... slots)
+: _slots{std::move(slots)...}
+{
+}
+
+template <typename Ret, typename... Params, typename... Slots>
+inline auto StaticSignal<Ret(Params...), Slots...>::operator()(ArgRef<Params>... args) -> EmitResult
+{
+    return emit(std::forward<ArgRef<Params>>(args)...);
+}
+
+template <typename Ret, typename... Params, typename... Slots>
+inline auto StaticSignal<Ret(Params...), Slots...>::emit(ArgRef<Params>... args) -> EmitResult
+{
+    if constexpr (std::is_same<Ret, Handled>::value) {
+        return emitCombined(until_handled{}, std::forward<ArgRef<Params>>(args)...);
+    } else {
+        std::apply(
+            [&args...](auto&... slots) { (static_cast<void>(slots(std::forward<ArgRef<Params>>(args)...)), ...); },
+            _slots);
+    }
+}
+
+template <typename Ret, typename... Params, typename... Slots>
+template <typename Combiner>
+inline auto StaticSignal<Ret(Params...), Slots...>::emitCombined(Combiner combiner, ArgRef<Params>... args)
+    -> decltype(combiner.result())
+{
+    static_assert(!std::is_void<Ret>::value, "Slots returning void can not be combined");
+    /// Short circuits at the first slot the combiner asks to stop after
+    std::apply(
+        [&combiner, &args...](auto&... slots) { (combiner(slots(std::forward<ArgRef<Params>>(args)...)) && ...); },
+        _slots);
+    return combiner.result();
+}
+
+template <typename Ret, typename... Params, typename... Slots>
+constexpr std::size_t StaticSignal<Ret(Params...), Slots...>::size()
+{
+    return sizeof...(Slots);
+}
+
+/// Make a static signal, deducing the slot types.
+/// @tparam SlotProto The signal signature, e.g. void(int).
+template <typename SlotProto, typename... Slots>
+inline StaticSignal<SlotProto, std::decay_t<Slots>...> makeStaticSignal(Slots&&... slots)
+{
+    return StaticSignal<SlotProto, std::decay_t<Slots>...>{std::forward<Slots>(slots)...};
+}
+
+/// ]]] StaticSignal ----------------------------------------------------------
+
+} // namespace moment
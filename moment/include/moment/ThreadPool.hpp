@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <moment/EventQueue.hpp>
+
+namespace moment {
+
+/// [[[ Latch -----------------------------------------------------------------
+
+/// A single use barrier that releases waiters once it has been counted down to zero.
+class Latch {
+public:
+    explicit Latch(std::size_t count);
+
+    /// Non-copyable / Non-movable
+    Latch(const Latch&) = delete;
+    Latch(Latch&&) = delete;
+    Latch& operator=(const Latch&) = delete;
+    Latch& operator=(Latch&&) = delete;
+
+    /// Decrement the count, releasing the waiters if it reaches zero.
+    void countDown();
+
+    /// Block until the count reaches zero.
+    void wait();
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _released;
+    std::size_t _count;
+};
+
+inline Latch::Latch(std::size_t count)
+: _count{count}
+{
+}
+
+inline void Latch::countDown()
+{
+    /// Notify under the lock, the waiter may destroy the latch as soon as it is released
+    std::lock_guard<std::mutex> lock{_mutex};
+    if (--_count == 0u) {
+        _released.notify_all();
+    }
+}
+
+inline void Latch::wait()
+{
+    std::unique_lock<std::mutex> lock{_mutex};
+    _released.wait(lock, [this]() { return _count == 0u; });
+}
+
+/// ]]] Latch -----------------------------------------------------------------
+
+/// [[[ ThreadPool ------------------------------------------------------------
+
+/// A fixed set of worker threads running tasks from a shared queue.
+/// @note An executor for queued connections and Signal::emitParallel.
+class ThreadPool {
+public:
+    /// @param threadCount The number of worker threads, at least one.
+    explicit ThreadPool(std::size_t threadCount = std::thread::hardware_concurrency());
+    /// Runs the pending tasks, then joins the workers.
+    ~ThreadPool();
+
+    /// Non-copyable / Non-movable
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    /// Post a task to be run by one of the workers.
+    /// @note May be called from any thread.
+    void post(Task&& task);
+
+    /// Get the number of worker threads.
+    std::size_t size() const;
+
+private:
+    /// Run tasks until stopped.
+    void work();
+
+    std::mutex _mutex;
+    std::condition_variable _available;
+    /// Guarded by _mutex.
+    std::deque<Task> _tasks;
+    /// Guarded by _mutex.
+    bool _stopping{false};
+    std::vector<std::thread> _workers;
+};
+
+inline ThreadPool::ThreadPool(std::size_t threadCount)
+{
+    threadCount = std::max<std::size_t>(threadCount, 1u);
+    _workers.reserve(threadCount);
+    for (auto I = 0u; I < threadCount; ++I) {
+        _workers.emplace_back([this]() { work(); });
+    }
+}
+
+inline ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _stopping = true;
+    }
+    _available.notify_all();
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+}
+
+inline void ThreadPool::post(Task&& task)
+{
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _tasks.push_back(std::move(task));
+    }
+    _available.notify_one();
+}
+
+inline std::size_t ThreadPool::size() const
+{
+    return _workers.size();
+}
+
+inline void ThreadPool::work()
+{
+    for (;;) {
+        /// Scoped to one iteration, so a finished task and its captures are destroyed before waiting for the next
+        auto task = Task{};
+        {
+            std::unique_lock<std::mutex> lock{_mutex};
+            _available.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+            if (_tasks.empty()) {
+                return;
+            }
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+        }
+        task();
+    }
+}
+
+/// ]]] ThreadPool ------------------------------------------------------------
+
+} // namespace moment
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <utility>
+
+#include <moment/ConnectionList.hpp>
+#include <moment/IntrusivePtr.hpp>
+#include <moment/LockFreeConnections.hpp>
+#include <moment/MemoryResource.hpp>
+
+/// Threading policies select the synchronization used by a Signal and its connections, e.g.
+/// Signal<void(int), moment::single_threaded>. A policy provides:
+///   Connections<T>  - The container a signal stores its connections in, CopyOnWriteConnections or
+///                     LockFreeConnections.
+///   Atomic<T>       - The atomic type used for state shared between emitters.
+///   nextId          - Generate a ConnectionId.
+///   instrumented    - Whether signals record metrics, see with_metrics.
+/// and for CopyOnWriteConnections:
+///   Mutex           - The mutex serializing connect and disconnect.
+///   SharedPtr<T>    - The shared pointer the connection list snapshots are held by.
+///   makeShared<T>   - Construct a T owned by a SharedPtr<T>, allocated from a memory resource.
+///   load / store    - Read and replace a SharedPtr<T> that emitters read concurrently.
+
+namespace moment {
+
+/// Identifies a connection among those made through the same policy.
+/// @note 64 bits never wrap in practice, connecting a billion times a second takes centuries to exhaust them.
+using ConnectionId = std::uint64_t;
+
+/// [[[ Synchronization primitives --------------------------------------------
+
+/// A mutex that does nothing, for state that is only accessed from one thread.
+class NullMutex {
+public:
+    void lock() {}
+    void unlock() {}
+    bool try_lock() { return true; }
+};
+
+/// An atomic that does not synchronize, for state that is only accessed from one thread.
+/// @note Mirrors the subset of the std::atomic interface used by moment.
+template <typename T>
+class NullAtomic {
+public:
+    NullAtomic() = default;
+    constexpr NullAtomic(T value)
+    : _value{value}
+    {
+    }
+
+    /// Non-copyable
+    NullAtomic(const NullAtomic&) = delete;
+    NullAtomic& operator=(const NullAtomic&) = delete;
+
+    T load(std::memory_order = std::memory_order_seq_cst) const { return _value; }
+    void store(T value, std::memory_order = std::memory_order_seq_cst) { _value = value; }
+    T exchange(T value, std::memory_order = std::memory_order_seq_cst) { return std::exchange(_value, value); }
+    T fetch_add(T value, std::memory_order = std::memory_order_seq_cst) { return std::exchange(_value, _value + value); }
+    T fetch_sub(T value, std::memory_order = std::memory_order_seq_cst) { return std::exchange(_value, _value - value); }
+
+    operator T() const { return _value; }
+    NullAtomic& operator=(T value)
+    {
+        _value = value;
+        return *this;
+    }
+
+private:
+    T _value;
+};
+
+/// Adds a reference count that does not synchronize to @p T so it can be held by an IntrusivePtr.
+/// @note Allocated from a memory resource with newObject, it is returned to the resource with the last reference.
+template <typename T>
+class NullCounted : public T {
+public:
+    template <typename... Args>
+    NullCounted(std::pmr::memory_resource* resource, Args&&... args)
+    : T(std::forward<Args>(args)...)
+    , _resource{resource}
+    {
+    }
+
+    void retain() { ++_refCount; }
+    void release()
+    {
+        /// Read before deleting, the count is part of the deleted object
+        const auto remaining = --_refCount;
+        if (remaining == 0u) {
+            deleteObject(_resource, this);
+        }
+    }
+
+private:
+    std::pmr::memory_resource* const _resource;
+    uint32_t _refCount{0u};
+};
+
+/// ]]] Synchronization primitives --------------------------------------------
+
+/// [[[ Threading policies ----------------------------------------------------
+
+/// Signals may be connected, disconnected and emitted from any thread. This is the default.
+struct multi_threaded {
+    template <typename T>
+    using Connections = CopyOnWriteConnections<T, multi_threaded>;
+
+    static constexpr bool instrumented = false;
+
+    using Mutex = std::mutex;
+
+    template <typename T>
+    using Atomic = std::atomic<T>;
+
+    template <typename T>
+    using SharedPtr = std::shared_ptr<T>;
+
+    template <typename T, typename... Args>
+    static SharedPtr<T> makeShared(std::pmr::memory_resource* resource, Args&&... args)
+    {
+        /// See allocate, the default resource is slow with allocate_shared
+        if (resource == std::pmr::new_delete_resource()) {
+            return std::make_shared<T>(std::forward<Args>(args)...);
+        }
+        return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>{resource}, std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    static SharedPtr<T> load(const SharedPtr<T>& ptr)
+    {
+        return std::atomic_load(&ptr);
+    }
+
+    template <typename T>
+    static void store(SharedPtr<T>& ptr, SharedPtr<T> value)
+    {
+        std::atomic_store(&ptr, std::move(value));
+    }
+
+    /// Each thread reserves a block of ids at once, so connecting from many threads rarely touches the shared counter.
+    static ConnectionId nextId()
+    {
+        constexpr auto blockSize = ConnectionId{1u} << 16u;
+        static std::atomic<ConnectionId> nextBlock{0u};
+        static thread_local ConnectionId id{0u};
+        static thread_local ConnectionId blockEnd{0u};
+        if (id == blockEnd) {
+            id = nextBlock.fetch_add(blockSize, std::memory_order_relaxed);
+            blockEnd = id + blockSize;
+        }
+        return id++;
+    }
+};
+
+/// Signals and their connections are only ever used from one thread, all synchronization is compiled out.
+struct single_threaded {
+    template <typename T>
+    using Connections = CopyOnWriteConnections<T, single_threaded>;
+
+    static constexpr bool instrumented = false;
+
+    using Mutex = NullMutex;
+
+    template <typename T>
+    using Atomic = NullAtomic<T>;
+
+    template <typename T>
+    using SharedPtr = IntrusivePtr<NullCounted<T>>;
+
+    template <typename T, typename... Args>
+    static SharedPtr<T> makeShared(std::pmr::memory_resource* resource, Args&&... args)
+    {
+        return SharedPtr<T>{newObject<NullCounted<T>>(resource, resource, std::forward<Args>(args)...)};
+    }
+
+    template <typename T>
+    static SharedPtr<T> load(const SharedPtr<T>& ptr)
+    {
+        return ptr;
+    }
+
+    template <typename T>
+    static void store(SharedPtr<T>& ptr, SharedPtr<T> value)
+    {
+        ptr = std::move(value);
+    }
+
+    /// Ids are unique per thread, which is all a signal confined to one thread can observe.
+    static ConnectionId nextId()
+    {
+        static thread_local ConnectionId id{0u};
+        return id++;
+    }
+};
+
+/// Signals may be connected, disconnected and emitted from any thread and none of these ever block.
+/// @note Emitting walks a linked list rather than an array, prefer multi_threaded unless connects and disconnects
+/// contend with each other or with emitters. Priorities and emitParallel are not supported.
+struct lock_free : multi_threaded {
+    template <typename T>
+    using Connections = LockFreeConnections<T>;
+};
+
+/// Signals synchronize as with @p Base and record metrics, see Instrumentation.hpp.
+/// @note Every emission counts itself and the connections it visited, every slot call is timed.
+template <typename Base>
+struct with_metrics : Base {
+    static constexpr bool instrumented = true;
+};
+
+/// ]]] Threading policies ----------------------------------------------------
+
+} // namespace moment
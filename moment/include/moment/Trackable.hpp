@@ -0,0 +1,75 @@
+#pragma once
+
+#include <mutex>
+#include <utility>
+
+#include <moment/ScopedConnection.hpp>
+
+namespace moment {
+
+/// [[[ Trackable -------------------------------------------------------------
+
+/// A base class for receivers whose member functions are connected with Signal::connect(object, memFunc).
+/// @note The connection is registered with the receiver on connect and disconnected when the receiver is destroyed, so
+/// emitting never checks whether the receiver is alive.
+/// @note Connections are disconnected in ~Trackable, after the derived destructor ran. If a signal may be emitted from
+/// another thread meanwhile, call disconnectTracked() first thing in the most derived destructor.
+class Trackable {
+public:
+    /// Own a connection, it is disconnected when this object is destroyed.
+    /// @note May be called from any thread.
+    template <typename SlotProto, typename Policy>
+    void track(Connection<SlotProto, Policy> connection);
+
+    /// Disconnect every tracked connection.
+    /// @note May be called from any thread.
+    void disconnectTracked();
+
+protected:
+    Trackable() = default;
+    ~Trackable();
+
+    /// A copy does not share the connections of the original.
+    Trackable(const Trackable&);
+    Trackable& operator=(const Trackable&);
+
+private:
+    std::mutex _mutex;
+    /// Guarded by _mutex.
+    ConnectionGroup _connections;
+};
+
+template <typename SlotProto, typename Policy>
+inline void Trackable::track(Connection<SlotProto, Policy> connection)
+{
+    std::lock_guard<std::mutex> lock{_mutex};
+    _connections.add(std::move(connection));
+}
+
+inline void Trackable::disconnectTracked()
+{
+    auto connections = ConnectionGroup{};
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        connections = std::move(_connections);
+    }
+}
+
+inline Trackable::~Trackable()
+{
+    disconnectTracked();
+}
+
+inline Trackable::Trackable(const Trackable&)
+: Trackable{}
+{
+}
+
+inline Trackable& Trackable::operator=(const Trackable&)
+{
+    return *this;
+}
+
+/// ]]] Trackable -------------------------------------------------------------
+
+} // namespace moment
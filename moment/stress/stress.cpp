@@ -0,0 +1,308 @@
+/// Hammers signals from several threads at once to catch races, build with -fsanitize=thread.
+/// Every scenario runs for a fixed time at 1, 2, 4, ... threads and reports the throughput of each operation, so
+/// scaling can be compared between releases. Exits with a non zero status if a scenario ends in a wrong state, the
+/// sanitizer stops the process on the first race it finds.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <moment/Signal.hpp>
+
+#if defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define MOMENT_STRESS_TSAN 1
+#endif
+#elif defined(__SANITIZE_THREAD__)
+#define MOMENT_STRESS_TSAN 1
+#endif
+
+#if MOMENT_STRESS_TSAN
+/// Fail on the first race rather than reporting them all once the run ends.
+extern "C" const char* __tsan_default_options()
+{
+    return "halt_on_error=1";
+}
+#endif
+
+namespace moment {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    double seconds{1.0};
+    unsigned maxThreads{std::max(4u, std::thread::hardware_concurrency())};
+};
+
+/// Operation counts of one thread, padded so threads do not share a cache line.
+struct alignas(64) Counts {
+    std::size_t emits{0u};
+    std::size_t connects{0u};
+    std::size_t disconnects{0u};
+    std::size_t moves{0u};
+};
+
+/// Run @p body on @p threadCount threads until @p seconds have passed.
+/// @param body Called with the thread index, its counts and a flag to poll.
+/// @returns The counts of every thread summed, and the time taken.
+template <typename Body>
+std::pair<Counts, double> run(unsigned threadCount, double seconds, Body&& body)
+{
+    auto counts = std::vector<Counts>(threadCount);
+    auto stop = std::atomic<bool>{false};
+    auto threads = std::vector<std::thread>{};
+    const auto start = Clock::now();
+    for (auto t = 0u; t < threadCount; ++t) {
+        threads.emplace_back([&body, &counts, &stop, t]() { body(t, counts[t], stop); });
+    }
+    std::this_thread::sleep_for(std::chrono::duration<double>{seconds});
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const auto elapsed = std::chrono::duration<double>{Clock::now() - start}.count();
+    auto total = Counts{};
+    for (const auto& count : counts) {
+        total.emits += count.emits;
+        total.connects += count.connects;
+        total.disconnects += count.disconnects;
+        total.moves += count.moves;
+    }
+    return {total, elapsed};
+}
+
+void report(const char* policy, const char* scenario, unsigned threadCount, const Counts& counts, double elapsed)
+{
+    const auto rate = [elapsed](std::size_t count) { return static_cast<double>(count) / elapsed / 1e6; };
+    std::printf("%-16s %-20s %8u %12.3f %12.3f %12.3f %12.3f\n",
+                policy,
+                scenario,
+                threadCount,
+                rate(counts.emits),
+                rate(counts.connects),
+                rate(counts.disconnects),
+                rate(counts.moves));
+}
+
+bool check(bool condition, const char* policy, const char* scenario, const char* what)
+{
+    if (!condition) {
+        std::fprintf(stderr, "%s %s: %s\n", policy, scenario, what);
+    }
+    return condition;
+}
+
+void slot(int) {}
+
+/// Every thread emits, connects and disconnects its own slots on one signal.
+template <typename Policy>
+bool stressMixed(const char* policy, unsigned threadCount, double seconds)
+{
+    Signal<void(int), Policy> sig{};
+    auto calls = std::atomic<std::size_t>{0u};
+    for (auto i = 0; i < 8; ++i) {
+        sig.connect(&slot);
+    }
+    const auto [counts, elapsed] = run(threadCount, seconds, [&sig, &calls](unsigned t, Counts& counts, auto& stop) {
+        auto connections = std::vector<Connection<void(int), Policy>>{};
+        for (auto i = std::size_t{0u}; !stop.load(std::memory_order_relaxed); ++i) {
+            if ((i + t) % 4u == 0u && connections.size() < 64u) {
+                connections.push_back(sig.connect([&calls](int) { calls.fetch_add(1u, std::memory_order_relaxed); }));
+                ++counts.connects;
+            } else if ((i + t) % 4u == 1u && !connections.empty()) {
+                connections.back().disconnect();
+                connections.pop_back();
+                ++counts.disconnects;
+            } else {
+                sig(1);
+                ++counts.emits;
+            }
+        }
+        for (auto& connection : connections) {
+            connection.disconnect();
+            ++counts.disconnects;
+        }
+    });
+    report(policy, "mixed", threadCount, counts, elapsed);
+    /// Every counting slot is gone, so another emission calls none of them
+    const auto before = calls.load();
+    sig(1);
+    return check(calls.load() == before, policy, "mixed", "a disconnected slot was called");
+}
+
+/// Every thread connects slots that are called at most once and emits, so the once slots race to be claimed.
+template <typename Policy>
+bool stressConnectOnce(const char* policy, unsigned threadCount, double seconds)
+{
+    Signal<void(int), Policy> sig{};
+    auto calls = std::atomic<std::size_t>{0u};
+    const auto [counts, elapsed] = run(threadCount, seconds, [&sig, &calls](unsigned, Counts& counts, auto& stop) {
+        while (!stop.load(std::memory_order_relaxed)) {
+            sig.connectOnce([&calls](int) { calls.fetch_add(1u, std::memory_order_relaxed); });
+            ++counts.connects;
+            sig(1);
+            ++counts.emits;
+        }
+    });
+    report(policy, "connect once", threadCount, counts, elapsed);
+    /// Each once slot is called exactly once, any left are called now
+    sig(1);
+    return check(calls.load() == counts.connects, policy, "connect once", "a once slot was not called exactly once");
+}
+
+/// One thread moves, emits and destroys signals while the others disconnect the connections it hands out.
+template <typename Policy>
+bool stressMoveAndDestroy(const char* policy, unsigned threadCount, double seconds)
+{
+    auto mutex = std::mutex{};
+    auto handedOut = std::vector<Connection<void(int), Policy>>{};
+    const auto [counts, elapsed] = run(threadCount, seconds, [&](unsigned t, Counts& counts, auto& stop) {
+        if (t == 0u) {
+            while (!stop.load(std::memory_order_relaxed)) {
+                auto first = std::make_unique<Signal<void(int), Policy>>();
+                for (auto i = 0; i < 16; ++i) {
+                    auto connection = first->connect(&slot);
+                    ++counts.connects;
+                    std::lock_guard<std::mutex> lock{mutex};
+                    handedOut.push_back(std::move(connection));
+                }
+                for (auto i = 0; i < 8; ++i) {
+                    auto second = std::move(*first);
+                    second(1);
+                    *first = std::move(second);
+                    counts.moves += 2u;
+                    ++counts.emits;
+                }
+                /// Destroyed while the other threads may still be disconnecting its connections
+                first.reset();
+            }
+            return;
+        }
+        while (!stop.load(std::memory_order_relaxed)) {
+            auto connection = Connection<void(int), Policy>{};
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                if (handedOut.empty()) {
+                    continue;
+                }
+                connection = std::move(handedOut.back());
+                handedOut.pop_back();
+            }
+            connection.disconnect();
+            ++counts.disconnects;
+        }
+    });
+    report(policy, "move and destroy", threadCount, counts, elapsed);
+    return check(std::none_of(handedOut.begin(),
+                              handedOut.end(),
+                              [](const auto& connection) { return connection.valid(); }),
+                 policy,
+                 "move and destroy",
+                 "a connection outlived its signal");
+}
+
+/// Every thread emits signals that one of their own slots destroys, while the other threads disconnect the
+/// connections it hands out. Every other signal hands out none, so the emission holds the last references to it.
+template <typename Policy>
+bool stressDestroyFromSlot(const char* policy, unsigned threadCount, double seconds)
+{
+    auto mutex = std::mutex{};
+    auto handedOut = std::vector<Connection<void(int), Policy>>{};
+    const auto [counts, elapsed] = run(threadCount, seconds, [&](unsigned, Counts& counts, auto& stop) {
+        for (auto i = std::size_t{0u}; !stop.load(std::memory_order_relaxed); ++i) {
+            if (i % 3u != 2u) {
+                auto sig = new Signal<void(int), Policy>{};
+                for (auto j = 0; j < 4; ++j) {
+                    auto connection = sig->connect(&slot);
+                    if (i % 3u == 1u) {
+                        std::lock_guard<std::mutex> lock{mutex};
+                        handedOut.push_back(std::move(connection));
+                    }
+                }
+                sig->connect([sig](int) { delete sig; });
+                for (auto j = 0; j < 4; ++j) {
+                    sig->connect(&slot);
+                }
+                counts.connects += 9u;
+                (*sig)(1);
+                ++counts.emits;
+                continue;
+            }
+            auto connection = Connection<void(int), Policy>{};
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                if (handedOut.empty()) {
+                    continue;
+                }
+                connection = std::move(handedOut.back());
+                handedOut.pop_back();
+            }
+            connection.disconnect();
+            ++counts.disconnects;
+        }
+    });
+    report(policy, "destroy from slot", threadCount, counts, elapsed);
+    return check(std::none_of(handedOut.begin(),
+                              handedOut.end(),
+                              [](const auto& connection) { return connection.valid(); }),
+                 policy,
+                 "destroy from slot",
+                 "a connection outlived its signal");
+}
+
+template <typename Policy>
+bool stressPolicy(const char* policy, const Options& options)
+{
+    auto passed = true;
+    for (auto threadCount = 1u; threadCount <= options.maxThreads; threadCount *= 2u) {
+        passed &= stressMixed<Policy>(policy, threadCount, options.seconds);
+        passed &= stressConnectOnce<Policy>(policy, threadCount, options.seconds);
+        passed &= stressDestroyFromSlot<Policy>(policy, threadCount, options.seconds);
+        if (threadCount > 1u) {
+            passed &= stressMoveAndDestroy<Policy>(policy, threadCount, options.seconds);
+        }
+    }
+    return passed;
+}
+
+} // namespace
+
+} // namespace moment
+
+int main(int argc, char** argv)
+{
+    auto options = moment::Options{};
+    for (auto i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--seconds") == 0) {
+            options.seconds = std::atof(argv[i + 1]);
+        } else if (std::strcmp(argv[i], "--threads") == 0) {
+            options.maxThreads = static_cast<unsigned>(std::max(1, std::atoi(argv[i + 1])));
+        } else {
+            std::fprintf(stderr, "usage: %s [--seconds per run] [--threads max]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    std::printf("%-16s %-20s %8s %12s %12s %12s %12s\n",
+                "policy",
+                "scenario",
+                "threads",
+                "emit M/s",
+                "connect M/s",
+                "disconn M/s",
+                "move M/s");
+    auto passed = true;
+    passed &= moment::stressPolicy<moment::multi_threaded>("multi_threaded", options);
+    passed &= moment::stressPolicy<moment::lock_free>("lock_free", options);
+    passed &= moment::stressPolicy<moment::with_metrics<moment::multi_threaded>>("with_metrics", options);
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
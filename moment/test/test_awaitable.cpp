@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <moment/Signal.hpp>
+
+#if MOMENT_COROUTINES
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <moment/Awaitable.hpp>
+#include <moment/EventQueue.hpp>
+
+namespace moment {
+
+using namespace testing;
+
+namespace {
+
+/// A coroutine that starts right away and is destroyed with its owner.
+/// @note Captures of a coroutine lambda live in the lambda, so the lambda must outlive the coroutine.
+class Routine {
+public:
+    struct promise_type {
+        Routine get_return_object() { return Routine{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    explicit Routine(std::coroutine_handle<promise_type> handle)
+    : _handle{handle}
+    {
+    }
+    ~Routine() { _handle.destroy(); }
+
+    Routine(const Routine&) = delete;
+    Routine& operator=(const Routine&) = delete;
+
+    bool done() const { return _handle.done(); }
+
+private:
+    std::coroutine_handle<promise_type> _handle;
+};
+
+} // namespace
+
+TEST(Awaitable, nextResumesWithArgument)
+{
+    /// Arrange
+    Signal<void(int)> sig{};
+    auto values = std::vector<int>{};
+    auto body = [&]() -> Routine { values.push_back(co_await sig.next()); };
+    auto routine = body();
+
+    /// Act
+    const auto suspended = !routine.done();
+    sig(5);
+    sig(6);
+
+    /// Assert
+    ASSERT_TRUE(suspended);
+    ASSERT_TRUE(routine.done());
+    ASSERT_THAT(values, ElementsAre(5));
+}
+
+TEST(Awaitable, nextYieldsTupleOfArguments)
+{
+    /// Arrange
+    Signal<void(int, const std::string&)> sig{};
+    auto result = std::tuple<int, std::string>{};
+    auto body = [&]() -> Routine { result = co_await sig.next(); };
+    auto routine = body();
+
+    /// Act
+    sig(1, "one");
+
+    /// Assert
+    ASSERT_TRUE(routine.done());
+    ASSERT_EQ(result, std::make_tuple(1, std::string{"one"}));
+}
+
+TEST(Awaitable, nextAwaitedInLoopSeesEveryEmission)
+{
+    /// Arrange
+    Signal<void()> sig{};
+    auto count = 0;
+    auto body = [&]() -> Routine {
+        while (count < 3) {
+            co_await sig.next();
+            ++count;
+        }
+    };
+    auto routine = body();
+
+    /// Act
+    for (auto i = 0; i < 5; ++i) {
+        sig();
+    }
+
+    /// Assert
+    ASSERT_TRUE(routine.done());
+    ASSERT_EQ(count, 3);
+}
+
+TEST(Awaitable, nextThroughExecutorResumesWhenDrained)
+{
+    /// Arrange
+    EventQueue queue{};
+    Signal<void(int)> sig{};
+    auto value = 0;
+    auto body = [&]() -> Routine { value = co_await sig.next(queue); };
+    auto routine = body();
+
+    /// Act
+    sig(7);
+    const auto doneBeforeDrain = routine.done();
+    const auto tasks = queue.drain();
+
+    /// Assert
+    ASSERT_FALSE(doneBeforeDrain);
+    ASSERT_EQ(tasks, 1u);
+    ASSERT_TRUE(routine.done());
+    ASSERT_EQ(value, 7);
+}
+
+TEST(Awaitable, destroyedWhileSuspendedDisconnects)
+{
+    /// Arrange
+    Signal<void(int)> sig{};
+    auto resumed = false;
+    {
+        auto body = [&]() -> Routine {
+            co_await sig.next();
+            resumed = true;
+        };
+        auto routine = body();
+    }
+
+    /// Act
+    sig(1);
+
+    /// Assert
+    ASSERT_FALSE(resumed);
+}
+
+TEST(Awaitable, streamBuffersAndDropsOldest)
+{
+    /// Arrange
+    Signal<void(int)> sig{};
+    SignalStream<void(int)> stream{sig, 2u};
+    auto values = std::vector<int>{};
+    sig(1);
+    sig(2);
+    sig(3);
+    const auto buffered = stream.size();
+
+    /// Act
+    auto body = [&]() -> Routine {
+        while (values.size() < 3u) {
+            values.push_back(co_await stream.next());
+        }
+    };
+    auto routine = body();
+    const auto doneBeforeEmit = routine.done();
+    sig(4);
+
+    /// Assert
+    ASSERT_EQ(buffered, 2u);
+    ASSERT_EQ(stream.dropped(), 1u);
+    ASSERT_FALSE(doneBeforeEmit);
+    ASSERT_TRUE(routine.done());
+    ASSERT_THAT(values, ElementsAre(2, 3, 4));
+}
+
+TEST(Awaitable, streamConsumesEmissionsFromAnotherThread)
+{
+    /// Arrange
+    constexpr auto emissionCount = 10000;
+    Signal<void(int)> sig{};
+    SignalStream<void(int)> stream{sig, 16u};
+    auto total = 0;
+    auto received = 0;
+    auto body = [&]() -> Routine {
+        while (received < emissionCount) {
+            total += co_await stream.next();
+            ++received;
+        }
+    };
+    auto routine = body();
+
+    /// Act
+    std::thread producer{[&sig]() {
+        for (auto i = 1; i <= emissionCount; ++i) {
+            sig(i);
+        }
+    }};
+    producer.join();
+
+    /// Assert
+    ASSERT_TRUE(routine.done());
+    /// Resumed on the producer, so the consumer is waiting again before the next emission
+    ASSERT_EQ(stream.dropped(), 0u);
+    ASSERT_EQ(total, emissionCount * (emissionCount + 1) / 2);
+}
+
+} // namespace moment
+
+#endif
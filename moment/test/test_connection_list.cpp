@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <memory>
+#include <vector>
+
+#include <moment/ConnectionList.hpp>
+#include <moment/LockFreeConnections.hpp>
+#include <moment/ThreadingPolicy.hpp>
+
+namespace moment {
+
+using namespace testing;
+
+namespace {
+
+struct FakeConnection {
+    bool valid() const { return _valid; }
+    bool invalidate() { return std::exchange(_valid, false); }
+    int priority() const { return 0; }
+
+    bool _valid{true};
+};
+
+using FakeConnectionPtr = std::shared_ptr<FakeConnection>;
+
+template <typename Connections>
+std::vector<FakeConnectionPtr> connectMany(Connections& connections, int count)
+{
+    auto result = std::vector<FakeConnectionPtr>{};
+    for (auto i = 0; i < count; ++i) {
+        result.push_back(std::make_shared<FakeConnection>());
+        connections.connect(result.back());
+    }
+    return result;
+}
+
+template <typename Connections>
+int countViewed(Connections& connections)
+{
+    auto count = 0;
+    connections.view().forEach([&count](FakeConnection&) { ++count; });
+    return count;
+}
+
+} // namespace
+
+TEST(CopyOnWriteConnections, disconnectOutsideEmitDropsDead)
+{
+    /// Arrange
+    CopyOnWriteConnections<FakeConnectionPtr, single_threaded> connections{};
+    const auto added = connectMany(connections, 4);
+
+    /// Act
+    for (auto i = 0; i < 3; ++i) {
+        connections.disconnect(added[i]);
+    }
+
+    /// Assert
+    ASSERT_EQ(connections.view().size(), 1u);
+}
+
+TEST(CopyOnWriteConnections, disconnectDuringEmitDeferredUntilOutermostEnds)
+{
+    /// Arrange
+    CopyOnWriteConnections<FakeConnectionPtr, multi_threaded> connections{};
+    const auto added = connectMany(connections, 4);
+    const FakeConnectionPtr* emitted = nullptr;
+
+    /// Act
+    {
+        const auto outer = connections.view();
+        emitted = outer.data();
+        {
+            const auto inner = connections.view();
+            for (auto i = 0; i < 3; ++i) {
+                connections.disconnect(added[i]);
+            }
+        }
+        ASSERT_EQ(connections.view().data(), emitted);
+        ASSERT_EQ(connections.view().size(), 4u);
+    }
+
+    /// Assert
+    ASSERT_NE(connections.view().data(), emitted);
+    ASSERT_EQ(connections.view().size(), 1u);
+    ASSERT_EQ(countViewed(connections), 1);
+}
+
+TEST(LockFreeConnections, disconnectDuringEmitDeferredUntilOutermostEnds)
+{
+    /// Arrange
+    LockFreeConnections<FakeConnectionPtr> connections{};
+    const auto added = connectMany(connections, 4);
+    auto nodes = 0;
+
+    /// Act
+    {
+        const auto view = connections.view();
+        for (auto i = 0; i < 3; ++i) {
+            connections.disconnect(added[i]);
+        }
+        /// Held by the test and a single node, the list was not rebuilt yet
+        nodes = added[3].use_count();
+    }
+
+    /// Assert
+    ASSERT_EQ(nodes, 2);
+    ASSERT_EQ(countViewed(connections), 1);
+    ASSERT_EQ(added[0].use_count(), 1);
+}
+
+} // namespace moment
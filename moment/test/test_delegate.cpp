@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+#include <string>
+
+#include <moment/Delegate.hpp>
+
+namespace {
+
+class Counter {
+public:
+    void add(int value) { total += value; }
+    int get() const { return total; }
+
+    int total{0};
+};
+
+} // namespace
+
+namespace moment {
+
+using namespace testing;
+
+TEST(Delegate, callLambda)
+{
+    /// Arrange
+    auto result = std::string{};
+    Delegate<void(const std::string&)> delegate{[&result](const std::string& s) { result = s; }};
+
+    /// Act
+    delegate("Test");
+
+    /// Assert
+    ASSERT_EQ(result, "Test");
+}
+
+TEST(Delegate, callMemberFunction)
+{
+    /// Arrange
+    Counter counter{};
+    Delegate<void(int)> add{&counter, &Counter::add};
+    Delegate<int()> get{&counter, &Counter::get};
+
+    /// Act
+    add(2);
+    add(3);
+
+    /// Assert
+    ASSERT_EQ(get(), 5);
+}
+
+TEST(Delegate, largeCallableStoredOnHeap)
+{
+    /// Arrange
+    auto values = std::array<int, 32>{};
+    values.back() = 7;
+    Delegate<int()> delegate{[values]() { return values.back(); }};
+
+    /// Act
+    auto moved = std::move(delegate);
+
+    /// Assert
+    ASSERT_FALSE(delegate);
+    ASSERT_EQ(moved(), 7);
+}
+
+TEST(Delegate, moveOnlyCallableDestroyedOnce)
+{
+    /// Arrange
+    auto value = std::make_shared<int>(4);
+    std::weak_ptr<int> weak = value;
+    {
+        Delegate<int()> delegate{[value{std::move(value)}]() { return *value; }};
+        Delegate<int()> moved{};
+
+        /// Act
+        moved = std::move(delegate);
+
+        /// Assert
+        ASSERT_EQ(moved(), 4);
+        ASSERT_FALSE(weak.expired());
+    }
+    ASSERT_TRUE(weak.expired());
+}
+
+TEST(Delegate, targetOfStoredType)
+{
+    /// Arrange
+    auto small = [](int) {};
+    auto large = [big = std::array<char, 128>{}](int) { (void)big; };
+    Delegate<void(int)> smallDelegate{small};
+    Delegate<void(int)> largeDelegate{large};
+
+    /// Act
+
+    /// Assert
+    ASSERT_NE(smallDelegate.target<decltype(small)>(), nullptr);
+    ASSERT_EQ(smallDelegate.target<decltype(large)>(), nullptr);
+    ASSERT_NE(largeDelegate.target<decltype(large)>(), nullptr);
+    ASSERT_EQ(largeDelegate.target<decltype(small)>(), nullptr);
+    ASSERT_EQ(Delegate<void(int)>{}.target<decltype(small)>(), nullptr);
+}
+
+} // namespace moment
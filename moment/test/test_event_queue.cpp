@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <moment/EventQueue.hpp>
+
+namespace moment {
+
+using namespace testing;
+
+TEST(EventQueue, drainRunsTasksInOrder)
+{
+    /// Arrange
+    EventQueue queue{};
+    auto calls = std::vector<int>{};
+    for (auto i = 0; i < 3; ++i) {
+        queue.post([&calls, i]() { calls.push_back(i); });
+    }
+
+    /// Act
+    const auto count = queue.drain();
+
+    /// Assert
+    ASSERT_EQ(count, 3u);
+    ASSERT_THAT(calls, ElementsAre(0, 1, 2));
+    ASSERT_EQ(queue.drain(), 0u);
+}
+
+TEST(EventQueue, postFromManyThreadsAllRun)
+{
+    /// Arrange
+    constexpr auto threadCount = 4;
+    constexpr auto postsPerThread = 1000;
+    EventQueue queue{};
+    auto calls = std::vector<int>(threadCount, 0);
+    auto producers = std::vector<std::thread>{};
+
+    /// Act
+    for (auto t = 0; t < threadCount; ++t) {
+        producers.emplace_back([&queue, &calls, t]() {
+            for (auto i = 0; i < postsPerThread; ++i) {
+                queue.post([&calls, t]() { ++calls[t]; });
+            }
+        });
+    }
+    auto count = std::size_t{0u};
+    while (count < threadCount * postsPerThread) {
+        count += queue.drain();
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    /// Assert
+    ASSERT_THAT(calls, Each(postsPerThread));
+}
+
+TEST(EventQueue, destroyedWithPendingTasksNotRun)
+{
+    /// Arrange
+    auto value = std::make_shared<int>(0);
+    std::weak_ptr<int> weak = value;
+    auto queue = std::make_unique<EventQueue>();
+    queue->post([value{std::move(value)}]() { ++*value; });
+
+    /// Act
+    queue.reset();
+
+    /// Assert
+    ASSERT_TRUE(weak.expired());
+}
+
+} // namespace moment
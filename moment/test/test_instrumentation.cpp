@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <moment/Signal.hpp>
+
+namespace moment {
+
+using namespace testing;
+
+TEST(Instrumentation, uninstrumentedSignalTakesNoSpace)
+{
+    /// Arrange
+    using Instrumented = Signal<void(int), with_metrics<multi_threaded>>;
+
+    /// Act
+    const auto size = sizeof(Signal<void(int)>);
+
+    /// Assert
+    ASSERT_LT(size, sizeof(Instrumented));
+    ASSERT_TRUE(std::is_empty<SignalInstrument<false>>::value);
+    ASSERT_TRUE(std::is_empty<SlotInstrument<false>>::value);
+}
+
+TEST(Instrumentation, countsEmitsAndVisitedSlots)
+{
+    /// Arrange
+    Signal<void(int), with_metrics<single_threaded>> sig{"test.countsEmitsAndVisitedSlots"};
+    sig.connect([](int) {});
+    sig.connect([](int) {});
+
+    /// Act
+    for (auto i = 0; i < 3; ++i) {
+        sig(i);
+    }
+    const auto snapshot = sig.metrics().snapshot();
+
+    /// Assert
+    ASSERT_EQ(snapshot.label, "test.countsEmitsAndVisitedSlots");
+    ASSERT_EQ(snapshot.emits, 3u);
+    ASSERT_EQ(snapshot.slotsVisited, 6u);
+    ASSERT_EQ(snapshot.slots.size(), 2u);
+    for (const auto& slot : snapshot.slots) {
+        auto calls = 0u;
+        for (const auto count : slot.calls) {
+            calls += count;
+        }
+        ASSERT_EQ(calls, 3u);
+    }
+}
+
+TEST(Instrumentation, emitBatchTimesEachSlotCall)
+{
+    /// Arrange
+    using Sig = Signal<void(int), with_metrics<single_threaded>>;
+    Sig sig{"test.emitBatchTimesEachSlotCall"};
+    sig.connect([](int) {});
+    sig.connectBatch([](const Sig::BatchItem*, std::size_t) {});
+    const auto items = std::vector<Sig::BatchItem>{{1}, {2}, {3}};
+
+    /// Act
+    sig.emitBatch(items);
+    const auto snapshot = sig.metrics().snapshot();
+
+    /// Assert
+    ASSERT_EQ(snapshot.emits, 3u);
+    auto calls = std::vector<unsigned>{};
+    for (const auto& slot : snapshot.slots) {
+        calls.push_back(0u);
+        for (const auto count : slot.calls) {
+            calls.back() += count;
+        }
+    }
+    /// The plain slot is timed once per item, the batch slot once for the whole batch
+    ASSERT_THAT(calls, UnorderedElementsAre(3u, 1u));
+}
+
+TEST(Instrumentation, emitRecordedAfterSlotDestroysSignal)
+{
+    /// Arrange
+    auto sig = new Signal<void(), with_metrics<multi_threaded>>{"test.emitRecordedAfterSlotDestroysSignal"};
+    sig->connect([]() {});
+    sig->connect([sig]() { delete sig; });
+
+    /// Act
+    (*sig)();
+    const auto snapshot = MetricsRegistry::instance().metrics("test.emitRecordedAfterSlotDestroysSignal")->snapshot();
+
+    /// Assert
+    ASSERT_EQ(snapshot.emits, 1u);
+    ASSERT_GE(snapshot.slotsVisited, 1u);
+}
+
+TEST(Instrumentation, signalsSharingLabelShareMetrics)
+{
+    /// Arrange
+    Signal<void(), with_metrics<multi_threaded>> first{"test.signalsSharingLabelShareMetrics"};
+    Signal<void(), with_metrics<multi_threaded>> second{"test.signalsSharingLabelShareMetrics"};
+
+    /// Act
+    first();
+    second();
+
+    /// Assert
+    ASSERT_EQ(&first.metrics(), &second.metrics());
+    ASSERT_EQ(first.metrics().snapshot().emits, 2u);
+}
+
+TEST(Instrumentation, disconnectedSlotsDropped)
+{
+    /// Arrange
+    Signal<void(), with_metrics<multi_threaded>> sig{"test.disconnectedSlotsDropped"};
+    sig.connect([]() {});
+    auto connections = std::vector<Connection<void(), with_metrics<multi_threaded>>>{};
+    for (auto i = 0; i < 3; ++i) {
+        connections.push_back(sig.connect([]() {}));
+    }
+
+    /// Act
+    for (auto& connection : connections) {
+        connection.disconnect();
+    }
+    connections.clear();
+
+    /// Assert
+    ASSERT_EQ(sig.metrics().snapshot().slots.size(), 1u);
+}
+
+TEST(Instrumentation, concurrentEmitsMerged)
+{
+    /// Arrange
+    Signal<void(), with_metrics<multi_threaded>> sig{"test.concurrentEmitsMerged"};
+    sig.connect([]() {});
+    auto threads = std::vector<std::thread>{};
+
+    /// Act
+    for (auto i = 0; i < 4; ++i) {
+        threads.emplace_back([&sig]() {
+            for (auto j = 0; j < 1000; ++j) {
+                sig();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    /// Assert
+    ASSERT_EQ(sig.metrics().snapshot().emits, 4000u);
+}
+
+TEST(Instrumentation, registryWritesEveryLabel)
+{
+    /// Arrange
+    Signal<void(), with_metrics<multi_threaded>> sig{"test.registryWritesEveryLabel"};
+    sig.connect([]() {});
+    sig();
+    std::ostringstream out{};
+
+    /// Act
+    MetricsRegistry::instance().write(out);
+
+    /// Assert
+    ASSERT_THAT(out.str(), HasSubstr("test.registryWritesEveryLabel emits=1 visited=1\n  connection="));
+}
+
+TEST(LatencyHistogram, percentileUpperBound)
+{
+    /// Arrange
+    LatencyHistogram histogram{};
+    for (auto i = 0; i < 99; ++i) {
+        histogram.record(10u);
+    }
+    histogram.record(1000u);
+
+    /// Act
+    const auto buckets = histogram.buckets();
+
+    /// Assert
+    ASSERT_EQ(LatencyHistogram::percentile(buckets, 0.5), 16u);
+    ASSERT_EQ(LatencyHistogram::percentile(buckets, 1.0), 1024u);
+}
+
+} // namespace moment
@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include <moment/Delegate.hpp>
+#include <moment/MemoryResource.hpp>
+#include <moment/Signal.hpp>
+
+namespace moment {
+
+using namespace testing;
+
+namespace {
+
+/// Counts the allocations made through it that were not returned yet.
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t allocations() const { return _allocations; }
+    std::ptrdiff_t outstanding() const { return _outstanding; }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++_allocations;
+        ++_outstanding;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* memory, std::size_t bytes, std::size_t alignment) override
+    {
+        --_outstanding;
+        std::pmr::new_delete_resource()->deallocate(memory, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    std::atomic<std::size_t> _allocations{0u};
+    std::atomic<std::ptrdiff_t> _outstanding{0};
+};
+
+/// Makes every allocation from the default resource throw while in scope.
+class NoDefaultResource {
+public:
+    NoDefaultResource()
+    : _previous{std::pmr::set_default_resource(std::pmr::null_memory_resource())}
+    {
+    }
+    ~NoDefaultResource() { std::pmr::set_default_resource(_previous); }
+
+private:
+    std::pmr::memory_resource* const _previous;
+};
+
+/// Connect, call and tear down slots of every kind on a signal allocating from @p resource.
+template <typename Policy>
+int exerciseSignal(CountingResource& resource)
+{
+    using Slot = typename Signal<void(int), Policy>::Slot;
+    using BatchItem = typename Signal<void(int), Policy>::BatchItem;
+    NoDefaultResource noDefault{};
+    auto calls = 0;
+    auto large = std::array<int, 32>{};
+    Signal<void(int), Policy> sig{&resource};
+    auto connections = std::vector<Connection<void(int), Policy>>{};
+    for (auto i = 0; i < 8; ++i) {
+        connections.push_back(sig.connect([&calls](int) { ++calls; }));
+    }
+    /// Too large to be stored inline
+    sig.connect(Slot{std::allocator_arg, sig.resource(), [&calls, large](int) { calls += 1 + large[0]; }});
+    sig.connectBatch([&calls](const BatchItem*, std::size_t count) { calls += static_cast<int>(count); });
+    for (auto i = 0; i < 6; ++i) {
+        connections[i].disconnect();
+    }
+    sig(1);
+    return calls;
+}
+
+} // namespace
+
+TEST(MemoryResource, newObjectReturnedToResource)
+{
+    /// Arrange
+    CountingResource resource{};
+
+    /// Act
+    const auto object = newObject<std::vector<int>>(&resource, 4u, 1);
+    const auto allocations = resource.allocations();
+    deleteObject(&resource, object);
+
+    /// Assert
+    ASSERT_EQ(allocations, 1u);
+    ASSERT_EQ(resource.outstanding(), 0);
+}
+
+TEST(MemoryResource, delegateLargeCallableAllocatedFromResource)
+{
+    /// Arrange
+    CountingResource resource{};
+    auto large = std::array<int, 32>{};
+    large[0] = 41;
+
+    /// Act
+    auto result = 0;
+    {
+        Delegate<int(int)> delegate{std::allocator_arg, &resource, [large](int value) { return large[0] + value; }};
+        Delegate<int(int)> moved{std::move(delegate)};
+        result = moved(1);
+    }
+
+    /// Assert
+    ASSERT_EQ(result, 42);
+    ASSERT_EQ(resource.allocations(), 1u);
+    ASSERT_EQ(resource.outstanding(), 0);
+}
+
+TEST(MemoryResource, delegateInlineCallableDoesNotAllocate)
+{
+    /// Arrange
+    CountingResource resource{};
+
+    /// Act
+    Delegate<int(int)> delegate{std::allocator_arg, &resource, [](int value) { return value; }};
+
+    /// Assert
+    ASSERT_EQ(delegate(1), 1);
+    ASSERT_EQ(resource.allocations(), 0u);
+}
+
+TEST(MemoryResource, signalStateAllocatedFromResource)
+{
+    /// Arrange
+    CountingResource resource{};
+
+    /// Act
+    const auto calls = exerciseSignal<multi_threaded>(resource);
+
+    /// Assert
+    ASSERT_EQ(calls, 4);
+    ASSERT_GT(resource.allocations(), 0u);
+    ASSERT_EQ(resource.outstanding(), 0);
+}
+
+TEST(MemoryResource, singleThreadedSignalStateAllocatedFromResource)
+{
+    /// Arrange
+    CountingResource resource{};
+
+    /// Act
+    const auto calls = exerciseSignal<single_threaded>(resource);
+
+    /// Assert
+    ASSERT_EQ(calls, 4);
+    ASSERT_GT(resource.allocations(), 0u);
+    ASSERT_EQ(resource.outstanding(), 0);
+}
+
+TEST(MemoryResource, lockFreeSignalStateAllocatedFromResource)
+{
+    /// Arrange
+    CountingResource resource{};
+
+    /// Act
+    const auto calls = exerciseSignal<lock_free>(resource);
+
+    /// Assert
+    ASSERT_EQ(calls, 4);
+    ASSERT_GT(resource.allocations(), 0u);
+    ASSERT_EQ(resource.outstanding(), 0);
+}
+
+TEST(MemoryResource, connectionOutlivingSignalReturnedToResource)
+{
+    /// Arrange
+    CountingResource resource{};
+    auto connection = Connection<void()>{};
+    {
+        Signal<void()> sig{&resource};
+        connection = sig.connect([]() {});
+    }
+    const auto outstanding = resource.outstanding();
+
+    /// Act
+    connection = Connection<void()>{};
+
+    /// Assert
+    /// The connection data and the store of the signal, which the connection keeps alive
+    ASSERT_EQ(outstanding, 2);
+    ASSERT_EQ(resource.outstanding(), 0);
+}
+
+} // namespace moment
@@ -1,7 +1,13 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <set>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <moment/Signal.hpp>
 
@@ -48,6 +54,31 @@ private:
     StrictMock<MockCallback> mockCallback;
 };
 
+/// Helper class counting how often it is copied and moved
+struct CopyCounter {
+    CopyCounter() = default;
+    CopyCounter(const CopyCounter& other)
+    : copies{other.copies + 1}
+    , moves{other.moves}
+    {
+    }
+    CopyCounter(CopyCounter&& other)
+    : copies{other.copies}
+    , moves{other.moves + 1}
+    {
+    }
+
+    int copies{0};
+    int moves{0};
+};
+
+/// Helper class recording the copies made of the argument its member function receives
+struct CopyReceiver {
+    void receive(const CopyCounter& counter) { copies.push_back(counter.copies + counter.moves); }
+
+    std::vector<int> copies;
+};
+
 } // namespace
 
 namespace moment {
@@ -251,6 +282,1123 @@ TEST(Signal, moveSignal_CallOldSignalFails)
     ASSERT_DEATH({sig();}, "Assertion failed*");
 }
 
+TEST(Signal, moveSignal_DisconnectAfterMove)
+{
+    /// Arrange
+    Signal<void()> sig{};
+    auto calls = 0;
+    auto connection = sig.connect([&calls]() { ++calls; });
+    auto other = sig.connect([&calls]() { ++calls; });
+    Signal<void()> movedSig = std::move(sig);
+
+    /// Act
+    const auto disconnected = connection.disconnect();
+    const auto disconnectedFromSignal = movedSig.disconnect(other);
+    movedSig();
+
+    /// Assert
+    ASSERT_TRUE(disconnected);
+    ASSERT_TRUE(disconnectedFromSignal);
+    ASSERT_EQ(calls, 0);
+}
+
+TEST(Signal, moveAssignSignal_PreviousConnectionsInvalid)
+{
+    /// Arrange
+    Signal<void()> sig{};
+    Signal<void()> target{};
+    auto calls = 0;
+    auto connection = sig.connect([&calls]() { ++calls; });
+    auto previous = target.connect([]() { FAIL(); });
+
+    /// Act
+    target = std::move(sig);
+    target();
+
+    /// Assert
+    ASSERT_FALSE(previous.valid());
+    ASSERT_TRUE(connection.valid());
+    ASSERT_EQ(calls, 1);
+}
+
+TEST(Signal, moveSignal_ReallocatingVectorConnectionsWork)
+{
+    /// Arrange
+    constexpr auto signalCount = 64;
+    auto signals = std::vector<Signal<void(int&)>>{};
+    auto connections = std::vector<Connection<void(int&)>>{};
+
+    /// Act
+    for (auto i = 0; i < signalCount; ++i) {
+        signals.emplace_back();
+        connections.push_back(signals.back().connect([](int& value) { ++value; }));
+    }
+    connections.front().disconnect();
+    auto total = 0;
+    for (auto& signal : signals) {
+        signal(total);
+    }
+
+    /// Assert
+    ASSERT_EQ(total, signalCount - 1);
+}
+
+TEST(Signal, disconnectFromSlotDuringEmit)
+{
+    /// Arrange
+    Signal<void()> sig{};
+    StrictMock<MockCallback> callback{};
+    Connection<void()> connection = sig.connect([]() {});
+    connection = sig.connect([&callback, &connection]() {
+        callback.voidCallback();
+        connection.disconnect();
+    });
+
+    /// Act
+    EXPECT_CALL(callback, voidCallback()).Times(1);
+    sig();
+    sig();
+
+    /// Assert
+    ASSERT_FALSE(connection.valid());
+}
+
+TEST(Signal, connectFromSlotDuringEmit_NewSlotCalledOnNextEmit)
+{
+    /// Arrange
+    Signal<void()> sig{};
+    StrictMock<MockCallback> callback{};
+    auto connected = false;
+    sig.connect([&sig, &callback, &connected]() {
+        if (!connected) {
+            connected = true;
+            sig.connect([&callback]() { callback.voidCallback(); });
+        }
+    });
+
+    /// Act
+    sig();
+    EXPECT_CALL(callback, voidCallback()).Times(1);
+    sig();
+
+    /// Assert
+}
+
+TEST(Signal, emitByReferenceNoCopies)
+{
+    /// Arrange
+    Signal<void(CopyCounter)> sig{};
+    auto copies = std::vector<int>{};
+    sig.connect([&copies](const CopyCounter& counter) { copies.push_back(counter.copies + counter.moves); });
+    sig.connect([&copies](const CopyCounter& counter) { copies.push_back(counter.copies + counter.moves); });
+
+    /// Act
+    sig.emit(CopyCounter{});
+
+    /// Assert
+    ASSERT_THAT(copies, ElementsAre(0, 0));
+}
+
+TEST(Signal, emitToMemberFunctionByReferenceNoCopies)
+{
+    /// Arrange
+    Signal<void(CopyCounter)> sig{};
+    CopyReceiver receiver{};
+    sig.connect(&receiver, &CopyReceiver::receive);
+    sig.connect(&receiver, std::mem_fn(&CopyReceiver::receive));
+
+    /// Act
+    sig.emit(CopyCounter{});
+
+    /// Assert
+    ASSERT_THAT(receiver.copies, ElementsAre(0, 0));
+}
+
+TEST(Signal, emitMoveMovesIntoLastSlot)
+{
+    /// Arrange
+    Signal<void(CopyCounter)> sig{};
+    auto copies = std::vector<int>{};
+    auto moves = std::vector<int>{};
+    auto slot = [&copies, &moves](CopyCounter counter) {
+        copies.push_back(counter.copies);
+        moves.push_back(counter.moves);
+    };
+    sig.connect(slot);
+    sig.connect(slot);
+
+    /// Act
+    sig.emitMove(CopyCounter{});
+
+    /// Assert
+    ASSERT_THAT(copies, ElementsAre(1, 0));
+    ASSERT_THAT(moves, ElementsAre(0, 1));
+}
+
+TEST(Signal, disconnectManyRemainingCalledInOrder)
+{
+    /// Arrange
+    Signal<void()> sig{};
+    auto calls = std::vector<int>{};
+    auto connections = std::vector<Connection<void()>>{};
+    for (auto i = 0; i < 10; ++i) {
+        connections.push_back(sig.connect([&calls, i]() { calls.push_back(i); }));
+    }
+
+    /// Act
+    for (auto i = 0; i < 10; ++i) {
+        if (i % 3 != 0) {
+            ASSERT_TRUE(connections[i].disconnect());
+        }
+    }
+    sig();
+
+    /// Assert
+    ASSERT_THAT(calls, ElementsAre(9, 6, 3, 0));
+}
+
+TEST(Signal, disconnectTwiceReturnsFalse)
+{
+    /// Arrange
+    Signal<void()> sig{};
+    auto connection = sig.connect([]() {});
+
+    /// Act
+    auto first = sig.disconnect(connection);
+    auto second = sig.disconnect(connection);
+
+    /// Assert
+    ASSERT_TRUE(first);
+    ASSERT_FALSE(second);
+}
+
+TEST(Signal, disconnectConnectionOfOtherSignalReturnsFalse)
+{
+    /// Arrange
+    Signal<void()> sig{};
+    Signal<void()> otherSig{};
+    auto connection = otherSig.connect([]() {});
+
+    /// Act
+    auto disconnected = sig.disconnect(connection);
+
+    /// Assert
+    ASSERT_FALSE(disconnected);
+    ASSERT_TRUE(connection.valid());
+}
+
+TEST(Signal, connectManyAllCalledNewestFirst)
+{
+    /// Arrange
+    Signal<void()> sig{};
+    auto calls = std::vector<int>{};
+    for (auto i = 0; i < 100; ++i) {
+        sig.connect([&calls, i]() { calls.push_back(i); });
+    }
+
+    /// Act
+    sig();
+
+    /// Assert
+    ASSERT_EQ(calls.size(), 100u);
+    ASSERT_TRUE(std::is_sorted(calls.rbegin(), calls.rend()));
+}
+
+TEST(Signal, connectionOutlivesSignalInvalid)
+{
+    /// Arrange
+    auto value = std::make_shared<int>(0);
+    std::weak_ptr<int> weak = value;
+    auto sig = std::make_unique<Signal<void()>>();
+    auto connection = sig->connect([value{std::move(value)}]() { ++*value; });
+
+    /// Act
+    sig.reset();
+
+    /// Assert
+    ASSERT_FALSE(connection.valid());
+    ASSERT_FALSE(weak.expired());
+}
+
+TEST(Signal, singleThreadedLambdaWithParams)
+{
+    /// Arrange
+    Signal<void(int, std::string), single_threaded> sig{};
+    StrictMock<MockCallback> callback{};
+    sig.connect([&callback](int i, std::string s) { callback.intAndStringCallback(i, s); });
+    auto arg1 = 5;
+    auto arg2 = std::string{"Test"};
+
+    /// Act
+    EXPECT_CALL(callback, intAndStringCallback(Eq(arg1), Eq(arg2)));
+    sig(arg1, arg2);
+
+    /// Assert
+}
+
+TEST(Signal, singleThreadedMemberFunctionDisconnect)
+{
+    /// Arrange
+    Signal<void(int), single_threaded> sig{};
+    MemberCallbacks callback{};
+    auto connection = sig.connect(&callback, std::mem_fn<void(int)>(&MemberCallbacks::overloadedCallback));
+    auto arg = 5;
+
+    /// Act
+    callback.expectOverloadedCallback(arg);
+    sig(arg);
+    connection.disconnect();
+    sig(arg);
+
+    /// Assert
+    ASSERT_FALSE(connection.valid());
+}
+
+TEST(Signal, singleThreadedMoveSignal_NewSignalConnectionsWork)
+{
+    /// Arrange
+    Signal<void(), single_threaded> sig{};
+    StrictMock<MockCallback> callback{};
+    auto connection = sig.connect([&callback]() { callback.voidCallback(); });
+
+    /// Act
+    Signal<void(), single_threaded> movedSig = std::move(sig);
+    EXPECT_CALL(callback, voidCallback());
+    movedSig();
+
+    /// Assert
+    ASSERT_TRUE(connection.valid());
+}
+
+TEST(Signal, queuedConnectionCalledOnDrain)
+{
+    /// Arrange
+    Signal<void(int, std::string)> sig{};
+    EventQueue queue{};
+    StrictMock<MockCallback> callback{};
+    sig.connect([&callback](int i, std::string s) { callback.intAndStringCallback(i, s); }, queue);
+
+    /// Act
+    sig(5, "Test");
+    EXPECT_CALL(callback, intAndStringCallback(Eq(5), Eq("Test")));
+    const auto count = queue.drain();
+
+    /// Assert
+    ASSERT_EQ(count, 1u);
+}
+
+TEST(Signal, queuedConnectionCopiesArguments)
+{
+    /// Arrange
+    Signal<void(const std::string&)> sig{};
+    EventQueue queue{};
+    auto received = std::string{};
+    sig.connect([&received](const std::string& s) { received = s; }, queue);
+    auto arg = std::string{"Test"};
+
+    /// Act
+    sig(arg);
+    arg = "Changed";
+    queue.drain();
+
+    /// Assert
+    ASSERT_EQ(received, "Test");
+}
+
+TEST(Signal, queuedConnectionDisconnectedBeforeDrainNotCalled)
+{
+    /// Arrange
+    Signal<void()> sig{};
+    EventQueue queue{};
+    StrictMock<MockCallback> callback{};
+    auto connection = sig.connect([&callback]() { callback.voidCallback(); }, queue);
+
+    /// Act
+    sig();
+    connection.disconnect();
+    queue.drain();
+
+    /// Assert
+}
+
+TEST(Signal, queuedConnectionCustomExecutor)
+{
+    /// Arrange
+    struct Executor {
+        void post(Task&& task) { tasks.push_back(std::move(task)); }
+        std::vector<Task> tasks;
+    };
+    Signal<void(int)> sig{};
+    Executor executor{};
+    auto calls = std::vector<int>{};
+    sig.connect([&calls](int i) { calls.push_back(i); }, executor);
+
+    /// Act
+    sig(1);
+    sig(2);
+    for (auto& task : executor.tasks) {
+        task();
+    }
+
+    /// Assert
+    ASSERT_THAT(calls, ElementsAre(1, 2));
+}
+
+TEST(Signal, coalescedConnectionCalledOnceWithLatest)
+{
+    /// Arrange
+    Signal<void(int, const std::string&)> sig{};
+    EventQueue queue{};
+    auto calls = std::vector<std::pair<int, std::string>>{};
+    sig.connectCoalesced([&calls](int i, const std::string& s) { calls.emplace_back(i, s); }, queue);
+
+    /// Act
+    sig(1, "one");
+    sig(2, "two");
+    sig(3, "three");
+    const auto tasks = queue.drain();
+    sig(4, "four");
+    queue.drain();
+
+    /// Assert
+    ASSERT_EQ(tasks, 1u);
+    ASSERT_THAT(calls, ElementsAre(Pair(3, "three"), Pair(4, "four")));
+}
+
+TEST(Signal, coalescedConnectionMergesEmissions)
+{
+    /// Arrange
+    Signal<void(int)> sig{};
+    EventQueue queue{};
+    auto calls = std::vector<int>{};
+    sig.connectCoalesced(
+        [&calls](int total) { calls.push_back(total); }, queue, [](int& pending, int value) { pending += value; });
+
+    /// Act
+    for (auto i = 1; i <= 4; ++i) {
+        sig(i);
+    }
+    queue.drain();
+
+    /// Assert
+    ASSERT_THAT(calls, ElementsAre(10));
+}
+
+TEST(Signal, coalescedConnectionEmittedBySlotRunsNextDrain)
+{
+    /// Arrange
+    Signal<void(int)> sig{};
+    EventQueue queue{};
+    auto calls = std::vector<int>{};
+    sig.connectCoalesced(
+        [&sig, &calls](int i) {
+            calls.push_back(i);
+            if (i == 1) {
+                sig(2);
+                sig(3);
+            }
+        },
+        queue);
+
+    /// Act
+    sig(1);
+    const auto tasks = queue.drain();
+
+    /// Assert
+    ASSERT_EQ(tasks, 2u);
+    ASSERT_THAT(calls, ElementsAre(1, 3));
+}
+
+TEST(Signal, coalescedConnectionDisconnectedBeforeDrainNotCalled)
+{
+    /// Arrange
+    Signal<void()> sig{};
+    EventQueue queue{};
+    StrictMock<MockCallback> callback{};
+    auto connection = sig.connectCoalesced([&callback]() { callback.voidCallback(); }, queue);
+
+    /// Act
+    sig();
+    sig();
+    connection.disconnect();
+    queue.drain();
+
+    /// Assert
+}
+
+TEST(Signal, emitBatchCallsEachSlotWithEveryItem)
+{
+    /// Arrange
+    Signal<void(int, const std::string&)> sig{};
+    auto calls = std::vector<std::string>{};
+    sig.connect([&calls](int i, const std::string& s) { calls.push_back("a" + std::to_string(i) + s); });
+    sig.connect([&calls](int i, const std::string& s) { calls.push_back("b" + std::to_string(i) + s); });
+    const auto items = std::vector<Signal<void(int, const std::string&)>::BatchItem>{{1, "x"}, {2, "y"}};
+
+    /// Act
+    sig.emitBatch(items);
+
+    /// Assert
+    ASSERT_THAT(calls, ElementsAre("b1x", "b2y", "a1x", "a2y"));
+}
+
+TEST(Signal, connectBatchReceivesWholeBatch)
+{
+    /// Arrange
+    using Sig = Signal<void(int)>;
+    Sig sig{};
+    auto batches = std::vector<std::vector<int>>{};
+    sig.connectBatch([&batches](const Sig::BatchItem* items, std::size_t count) {
+        batches.emplace_back();
+        std::transform(items, items + count, std::back_inserter(batches.back()), [](const auto& item) {
+            return std::get<0>(item);
+        });
+    });
+    const auto items = std::vector<Sig::BatchItem>{{1}, {2}, {3}};
+
+    /// Act
+    sig.emitBatch(items);
+    sig(4);
+
+    /// Assert
+    ASSERT_THAT(batches, ElementsAre(ElementsAre(1, 2, 3), ElementsAre(4)));
+}
+
+TEST(Signal, emitBatchDisconnectFromSlotStopsBatch)
+{
+    /// Arrange
+    Signal<void(int)> sig{};
+    auto calls = std::vector<int>{};
+    Connection<void(int)> connection = sig.connect([&calls, &connection](int i) {
+        calls.push_back(i);
+        connection.disconnect();
+    });
+    const auto items = std::vector<Signal<void(int)>::BatchItem>{{1}, {2}};
+
+    /// Act
+    sig.emitBatch(items);
+
+    /// Assert
+    ASSERT_THAT(calls, ElementsAre(1));
+}
+
+TEST(Signal, emitCombinedSum)
+{
+    /// Arrange
+    Signal<int(int)> sig{};
+    sig.connect([](int i) { return i; });
+    sig.connect([](int i) { return 2 * i; });
+
+    /// Act
+    const auto result = sig.emitCombined(sum<int>{}, 5);
+
+    /// Assert
+    ASSERT_EQ(result, 15);
+}
+
+TEST(Signal, emitCombinedLastWithoutSlotsEmpty)
+{
+    /// Arrange
+    Signal<int()> sig{};
+
+    /// Act
+    const auto result = sig.emitCombined(last<int>{});
+
+    /// Assert
+    ASSERT_FALSE(result.has_value());
+}
+
+TEST(Signal, emitCombinedCollectInCallOrder)
+{
+    /// Arrange
+    Signal<int()> sig{};
+    sig.connect([]() { return 1; });
+    sig.connect([]() { return 2; });
+
+    /// Act
+    const auto result = sig.emitCombined(collect<int>{});
+
+    /// Assert
+    ASSERT_THAT(result, ElementsAre(2, 1));
+}
+
+TEST(Signal, emitCombinedLogicalAndStopsAtFalse)
+{
+    /// Arrange
+    Signal<bool()> sig{};
+    StrictMock<MockCallback> callback{};
+    sig.connect([&callback]() {
+        callback.voidCallback();
+        return true;
+    });
+    sig.connect([]() { return false; });
+
+    /// Act
+    const auto result = sig.emitCombined(logical_and{});
+
+    /// Assert
+    ASSERT_FALSE(result);
+}
+
+TEST(Signal, emitCombinedFirstNonNullStopsAtFirst)
+{
+    /// Arrange
+    Signal<const int*()> sig{};
+    auto value = 5;
+    StrictMock<MockCallback> callback{};
+    sig.connect([&callback]() -> const int* {
+        callback.voidCallback();
+        return nullptr;
+    });
+    sig.connect([&value]() -> const int* { return &value; });
+    sig.connect([]() -> const int* { return nullptr; });
+
+    /// Act
+    const auto result = sig.emitCombined(first_non_null<const int*>{});
+
+    /// Assert
+    ASSERT_EQ(result, &value);
+}
+
+TEST(Signal, handledStopsAtFirstHandledSlot)
+{
+    /// Arrange
+    Signal<Handled(int)> sig{};
+    StrictMock<MockCallback> callback{};
+    sig.connect([&callback](int) {
+        callback.voidCallback();
+        return Handled::Yes;
+    });
+    sig.connect([](int i) { return i == 5 ? Handled::Yes : Handled::No; });
+    sig.connect([](int) { return Handled::No; });
+
+    /// Act
+    const auto result = sig(5);
+
+    /// Assert
+    ASSERT_EQ(result, Handled::Yes);
+}
+
+TEST(Signal, handledNoSlotHandledCallsAll)
+{
+    /// Arrange
+    Signal<Handled(int)> sig{};
+    StrictMock<MockCallback> callback{};
+    sig.connect([&callback](int) {
+        callback.voidCallback();
+        return Handled::No;
+    });
+    sig.connect([](int) { return Handled::No; });
+
+    /// Act
+    EXPECT_CALL(callback, voidCallback());
+    const auto result = sig(5);
+
+    /// Assert
+    ASSERT_EQ(result, Handled::No);
+}
+
+TEST(Signal, priorityHigherCalledFirst)
+{
+    /// Arrange
+    Signal<void()> sig{};
+    auto calls = std::vector<int>{};
+    sig.connect([&calls]() { calls.push_back(1); }, 1);
+    sig.connect([&calls]() { calls.push_back(3); }, 3);
+    sig.connect([&calls]() { calls.push_back(0); });
+    sig.connect([&calls]() { calls.push_back(2); }, 2);
+
+    /// Act
+    sig();
+
+    /// Assert
+    ASSERT_THAT(calls, ElementsAre(3, 2, 1, 0));
+}
+
+TEST(Signal, priorityEqualNewestFirst)
+{
+    /// Arrange
+    Signal<void()> sig{};
+    auto calls = std::vector<int>{};
+    sig.connect([&calls]() { calls.push_back(0); }, 5);
+    sig.connect([&calls]() { calls.push_back(9); }, 9);
+    sig.connect([&calls]() { calls.push_back(1); }, 5);
+
+    /// Act
+    sig();
+
+    /// Assert
+    ASSERT_THAT(calls, ElementsAre(9, 1, 0));
+}
+
+TEST(Signal, priorityOrderKeptAfterDisconnect)
+{
+    /// Arrange
+    Signal<void()> sig{};
+    auto calls = std::vector<int>{};
+    auto connections = std::vector<Connection<void()>>{};
+    for (auto i = 0; i < 4; ++i) {
+        connections.push_back(sig.connect([&calls, i]() { calls.push_back(i); }, i));
+    }
+
+    /// Act
+    connections[1].disconnect();
+    connections[2].disconnect();
+    connections[3].disconnect();
+    sig.connect([&calls]() { calls.push_back(10); }, -1);
+    sig.connect([&calls]() { calls.push_back(20); }, 2);
+    sig();
+
+    /// Assert
+    ASSERT_THAT(calls, ElementsAre(20, 0, 10));
+}
+
+TEST(Signal, emitParallelCallsEverySlotOnce)
+{
+    /// Arrange
+    constexpr auto slotCount = 100;
+    Signal<void(int)> sig{};
+    ThreadPool pool{4u};
+    auto calls = std::vector<std::atomic<int>>(slotCount);
+    for (auto i = 0; i < slotCount; ++i) {
+        sig.connect([&calls, i](int value) { calls[i] += value; });
+    }
+
+    /// Act
+    sig.emitParallel(pool, 8u, 1);
+    sig.emitParallel(pool, 1000u, 1);
+
+    /// Assert
+    ASSERT_TRUE(std::all_of(calls.begin(), calls.end(), [](const auto& count) { return count == 2; }));
+}
+
+TEST(Signal, lockFreeLambdaWithParams)
+{
+    /// Arrange
+    Signal<void(int, std::string), lock_free> sig{};
+    StrictMock<MockCallback> callback{};
+    sig.connect([&callback](int i, std::string s) { callback.intAndStringCallback(i, s); });
+    auto arg1 = 5;
+    auto arg2 = std::string{"Test"};
+
+    /// Act
+    EXPECT_CALL(callback, intAndStringCallback(Eq(arg1), Eq(arg2)));
+    sig(arg1, arg2);
+
+    /// Assert
+}
+
+TEST(Signal, lockFreeDisconnectManyRemainingCalledInOrder)
+{
+    /// Arrange
+    Signal<void(), lock_free> sig{};
+    auto calls = std::vector<int>{};
+    auto connections = std::vector<Connection<void(), lock_free>>{};
+    for (auto i = 0; i < 10; ++i) {
+        connections.push_back(sig.connect([&calls, i]() { calls.push_back(i); }));
+    }
+
+    /// Act
+    for (auto i = 0; i < 10; i += 3) {
+        ASSERT_TRUE(connections[i].disconnect());
+    }
+    ASSERT_FALSE(connections[0].disconnect());
+    connections[1].disconnect();
+    connections[2].disconnect();
+    sig();
+
+    /// Assert
+    ASSERT_THAT(calls, ElementsAre(8, 7, 5, 4));
+}
+
+TEST(Signal, lockFreeMoveSignal_NewSignalConnectionsWork)
+{
+    /// Arrange
+    Signal<void(), lock_free> sig{};
+    StrictMock<MockCallback> callback{};
+    auto connection = sig.connect([&callback]() { callback.voidCallback(); });
+
+    /// Act
+    Signal<void(), lock_free> movedSig = std::move(sig);
+    EXPECT_CALL(callback, voidCallback());
+    movedSig();
+
+    /// Assert
+    ASSERT_TRUE(connection.valid());
+    ASSERT_TRUE(connection.disconnect());
+}
+
+TEST(Signal, lockFreeDisconnectedSlotsReclaimed)
+{
+    /// Arrange
+    Signal<void(), lock_free> sig{};
+    auto value = std::make_shared<int>(0);
+    std::weak_ptr<int> weak = value;
+    sig.connect([value{std::move(value)}]() { ++*value; }).disconnect();
+
+    /// Act
+    for (auto i = 0; i < 4; ++i) {
+        sig.connect([]() {}).disconnect();
+        sig();
+    }
+
+    /// Assert
+    ASSERT_TRUE(weak.expired());
+}
+
+TEST(Signal, lockFreeConcurrentConnectDisconnectEmit)
+{
+    /// Arrange
+    constexpr auto threadCount = 4;
+    constexpr auto iterations = 2000;
+    Signal<void(int), lock_free> sig{};
+    auto total = std::atomic<int>{0};
+    auto permanent = sig.connect([&total](int i) { total += i; });
+    auto threads = std::vector<std::thread>{};
+
+    /// Act
+    for (auto t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&sig]() {
+            for (auto i = 0; i < iterations; ++i) {
+                auto connection = sig.connect([](int) {});
+                sig(1);
+                connection.disconnect();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    /// Assert
+    ASSERT_EQ(total, threadCount * iterations);
+    ASSERT_TRUE(permanent.valid());
+}
+
+TEST(Signal, disconnectAfterSignalDestroyed)
+{
+    /// Arrange
+    auto signal = std::make_unique<Signal<void()>>();
+    auto connection = signal->connect([]() {});
+
+    /// Act
+    signal.reset();
+
+    /// Assert
+    ASSERT_FALSE(connection.valid());
+    ASSERT_FALSE(connection.disconnect());
+}
+
+TEST(Signal, emptyConnection)
+{
+    /// Arrange
+    auto connection = Connection<void()>{};
+
+    /// Act
+    const auto disconnected = connection.disconnect();
+
+    /// Assert
+    ASSERT_FALSE(disconnected);
+    ASSERT_FALSE(connection.valid());
+    ASSERT_TRUE(connection == Connection<void()>{});
+}
+
+TEST(Signal, disconnectFromReentrantEmit)
+{
+    /// Arrange
+    Signal<void(int)> sig{};
+    auto calls = std::vector<int>{};
+    auto others = std::vector<Connection<void(int)>>{};
+    for (auto i = 0; i < 4; ++i) {
+        others.push_back(sig.connect([&calls](int depth) { calls.push_back(depth); }));
+    }
+    auto self = Connection<void(int)>{};
+    self = sig.connect([&sig, &others, &self](int depth) {
+        if (depth == 0) {
+            sig(depth + 1);
+            return;
+        }
+        self.disconnect();
+        for (auto& connection : others) {
+            connection.disconnect();
+        }
+    });
+
+    /// Act
+    sig(0);
+    sig(0);
+
+    /// Assert
+    ASSERT_FALSE(self.valid());
+    ASSERT_TRUE(calls.empty());
+}
+
+TEST(Signal, connectOnceCalledOnce)
+{
+    /// Arrange
+    Signal<void(int)> sig{};
+    auto calls = std::vector<int>{};
+    auto connection = sig.connectOnce([&calls](int value) { calls.push_back(value); });
+
+    /// Act
+    sig(1);
+    sig(2);
+
+    /// Assert
+    ASSERT_THAT(calls, ElementsAre(1));
+    ASSERT_FALSE(connection.valid());
+}
+
+TEST(Signal, connectOnceDisconnectedBeforeEmitNotCalled)
+{
+    /// Arrange
+    Signal<void(), single_threaded> sig{};
+    auto calls = 0;
+    auto connection = sig.connectOnce([&calls]() { ++calls; });
+
+    /// Act
+    const auto disconnected = connection.disconnect();
+    sig();
+
+    /// Assert
+    ASSERT_TRUE(disconnected);
+    ASSERT_EQ(calls, 0);
+}
+
+TEST(Signal, connectOnceReemitFromSlotNotCalledAgain)
+{
+    /// Arrange
+    Signal<void()> sig{};
+    auto calls = 0;
+    sig.connectOnce([&sig, &calls]() {
+        ++calls;
+        sig();
+    });
+
+    /// Act
+    sig();
+
+    /// Assert
+    ASSERT_EQ(calls, 1);
+}
+
+TEST(Signal, connectOnceConcurrentEmitCalledOnce)
+{
+    /// Arrange
+    Signal<void(), lock_free> sig{};
+    auto calls = std::atomic<int>{0};
+    for (auto i = 0; i < 100; ++i) {
+        sig.connectOnce([&calls]() { ++calls; });
+    }
+    auto threads = std::vector<std::thread>{};
+
+    /// Act
+    for (auto i = 0; i < 4; ++i) {
+        threads.emplace_back([&sig]() { sig(); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    /// Assert
+    ASSERT_EQ(calls.load(), 100);
+}
+
+TEST(Signal, connectionEqualityIsIdentity)
+{
+    /// Arrange
+    Signal<void()> sig{};
+    auto first = sig.connect([]() {});
+    auto second = sig.connect([]() {});
+    auto copy = first;
+
+    /// Act
+    first.disconnect();
+
+    /// Assert
+    ASSERT_TRUE(first == copy);
+    ASSERT_TRUE(first != second);
+    ASSERT_TRUE(first != Connection<void()>{});
+    ASSERT_FALSE(Connection<void()>{} != Connection<void()>{});
+}
+
+TEST(Signal, connectionIdsUniqueAcrossThreads)
+{
+    /// Arrange
+    constexpr auto threadCount = 4;
+    constexpr auto iterations = 1000;
+    auto ids = std::vector<std::vector<ConnectionId>>(threadCount);
+    auto threads = std::vector<std::thread>{};
+
+    /// Act
+    for (auto t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&ids = ids[t]]() {
+            for (auto i = 0; i < iterations; ++i) {
+                ids.push_back(multi_threaded::nextId());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    /// Assert
+    auto unique = std::set<ConnectionId>{};
+    for (const auto& threadIds : ids) {
+        unique.insert(threadIds.begin(), threadIds.end());
+    }
+    ASSERT_EQ(unique.size(), static_cast<std::size_t>(threadCount * iterations));
+}
+
+TEST(Signal, disconnectWhileSignalDestroyed)
+{
+    /// Arrange
+    constexpr auto rounds = 200;
+    constexpr auto connectionCount = 16;
+    auto connections = std::vector<Connection<void()>>{};
+
+    /// Act
+    for (auto round = 0; round < rounds; ++round) {
+        auto sig = std::make_unique<Signal<void()>>();
+        for (auto i = 0; i < connectionCount; ++i) {
+            connections.push_back(sig->connect([]() {}));
+        }
+        std::thread disconnecter{[&connections]() {
+            for (auto& connection : connections) {
+                connection.disconnect();
+            }
+        }};
+        sig.reset();
+        disconnecter.join();
+    }
+
+    /// Assert
+    ASSERT_TRUE(std::none_of(
+        connections.begin(), connections.end(), [](const auto& connection) { return connection.valid(); }));
+}
+
+template <typename Policy>
+std::vector<int> emitToSlotDestroyingSignal()
+{
+    auto sig = new Signal<void(), Policy>{};
+    auto calls = std::vector<int>{};
+    sig->connect([&calls]() { calls.push_back(0); });
+    sig->connect([&calls, sig]() {
+        calls.push_back(1);
+        delete sig;
+    });
+    sig->connect([&calls]() { calls.push_back(2); });
+    (*sig)();
+    return calls;
+}
+
+TEST(Signal, emptyOnceEveryConnectionDisconnected)
+{
+    /// Arrange
+    Signal<void()> sig{};
+    const auto emptyBefore = sig.empty();
+    auto first = sig.connect([]() {});
+    auto second = sig.connect([]() {});
+
+    /// Act
+    first.disconnect();
+    const auto emptyAfterFirst = sig.empty();
+    second.disconnect();
+
+    /// Assert
+    ASSERT_TRUE(emptyBefore);
+    ASSERT_FALSE(emptyAfterFirst);
+    ASSERT_TRUE(sig.empty());
+}
+
+TEST(Signal, slotDestroysSignal)
+{
+    /// Arrange
+
+    /// Act
+    const auto calls = emitToSlotDestroyingSignal<multi_threaded>();
+
+    /// Assert
+    /// The slots left were disconnected with the signal
+    ASSERT_THAT(calls, Contains(1));
+    ASSERT_EQ(calls.back(), 1);
+}
+
+TEST(Signal, instrumentedSlotDestroysSignal)
+{
+    /// Arrange
+
+    /// Act
+    const auto calls = emitToSlotDestroyingSignal<with_metrics<multi_threaded>>();
+
+    /// Assert
+    /// The slots left were disconnected with the signal
+    ASSERT_THAT(calls, Contains(1));
+    ASSERT_EQ(calls.back(), 1);
+}
+
+TEST(Signal, lockFreeSlotDestroysSignal)
+{
+    /// Arrange
+
+    /// Act
+    const auto calls = emitToSlotDestroyingSignal<lock_free>();
+
+    /// Assert
+    /// The slots left were disconnected with the signal
+    ASSERT_THAT(calls, Contains(1));
+    ASSERT_EQ(calls.back(), 1);
+}
+
+/// Emit @p Policy signal twice from the slot of another signal, the first emission disconnects all but one of its
+/// connections.
+/// @returns The number of connections the two emissions visited.
+template <typename Policy>
+std::uint64_t visitedByNestedEmits(const char* label)
+{
+    Signal<void(), with_metrics<Policy>> inner{label};
+    auto connections = std::vector<Connection<void(), with_metrics<Policy>>>{};
+    for (auto i = 0; i < 99; ++i) {
+        connections.push_back(inner.connect([]() {}));
+    }
+    inner.connect([&connections]() {
+        for (auto& connection : connections) {
+            connection.disconnect();
+        }
+    });
+    Signal<void()> outer{};
+    outer.connect([&inner]() {
+        inner();
+        inner();
+    });
+    outer();
+    return inner.metrics().snapshot().slotsVisited;
+}
+
+TEST(Signal, nestedEmitDropsDisconnected)
+{
+    /// Arrange
+
+    /// Act
+    const auto visited = visitedByNestedEmits<multi_threaded>("test.nestedEmitDropsDisconnected");
+
+    /// Assert
+    /// Dropped once the first emission of the inner signal ended, although the outer one had not
+    ASSERT_EQ(visited, 101u);
+}
+
+TEST(Signal, lockFreeNestedEmitDropsDisconnected)
+{
+    /// Arrange
+
+    /// Act
+    const auto visited = visitedByNestedEmits<lock_free>("test.lockFreeNestedEmitDropsDisconnected");
+
+    /// Assert
+    /// Dropped once the first emission of the inner signal ended, although the outer one had not
+    ASSERT_EQ(visited, 101u);
+}
+
 } // namespace moment
 
 /// End Tests
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <memory>
+#include <vector>
+
+#include <moment/ScopedConnection.hpp>
+
+namespace moment {
+
+using namespace testing;
+
+TEST(ScopedConnection, disconnectsWhenDestroyed)
+{
+    /// Arrange
+    Signal<void()> signal{};
+    auto calls = 0;
+
+    /// Act
+    {
+        ScopedConnection<void()> connection{signal.connect([&calls]() { ++calls; })};
+        signal();
+        ASSERT_TRUE(connection.valid());
+    }
+    signal();
+
+    /// Assert
+    ASSERT_EQ(calls, 1);
+}
+
+TEST(ScopedConnection, releaseLeavesConnected)
+{
+    /// Arrange
+    Signal<void()> signal{};
+    auto calls = 0;
+    auto released = Connection<void()>{};
+
+    /// Act
+    {
+        ScopedConnection<void()> connection{signal.connect([&calls]() { ++calls; })};
+        released = connection.release();
+        ASSERT_FALSE(connection.valid());
+    }
+    signal();
+
+    /// Assert
+    ASSERT_EQ(calls, 1);
+    ASSERT_TRUE(released.valid());
+}
+
+TEST(ScopedConnection, moveAssignDisconnectsPrevious)
+{
+    /// Arrange
+    Signal<void()> signal{};
+    auto first = 0;
+    auto second = 0;
+    ScopedConnection<void()> connection{signal.connect([&first]() { ++first; })};
+
+    /// Act
+    connection = ScopedConnection<void()>{signal.connect([&second]() { ++second; })};
+    signal();
+
+    /// Assert
+    ASSERT_EQ(first, 0);
+    ASSERT_EQ(second, 1);
+    ASSERT_TRUE(connection.valid());
+}
+
+TEST(ScopedConnection, destroyedAfterSignal)
+{
+    /// Arrange
+    auto signal = std::make_unique<Signal<void()>>();
+    ScopedConnection<void()> connection{signal->connect([]() {})};
+
+    /// Act
+    signal.reset();
+
+    /// Assert
+    ASSERT_FALSE(connection.valid());
+    ASSERT_FALSE(connection.disconnect());
+}
+
+TEST(ConnectionGroup, disconnectsEveryConnection)
+{
+    /// Arrange
+    Signal<void()> voidSignal{};
+    Signal<void(int), single_threaded> intSignal{};
+    auto calls = 0;
+    auto kept = voidSignal.connect([]() {});
+    ConnectionGroup group{};
+    for (auto i = 0; i < 3; ++i) {
+        group.add(voidSignal.connect([&calls]() { ++calls; }));
+        group.add(intSignal.connect([&calls](int) { ++calls; }));
+    }
+
+    /// Act
+    group.disconnect();
+    voidSignal();
+    intSignal(1);
+
+    /// Assert
+    ASSERT_EQ(calls, 0);
+    ASSERT_TRUE(group.empty());
+    ASSERT_TRUE(kept.valid());
+}
+
+TEST(ConnectionGroup, disconnectsWhenDestroyed)
+{
+    /// Arrange
+    Signal<void()> signal{};
+    auto calls = 0;
+
+    /// Act
+    {
+        ConnectionGroup group{};
+        group.add(signal.connect([&calls]() { ++calls; }));
+        group.add(signal.connect([&calls]() { ++calls; }));
+        ASSERT_EQ(group.size(), 2u);
+        signal();
+    }
+    signal();
+
+    /// Assert
+    ASSERT_EQ(calls, 2);
+}
+
+TEST(ConnectionGroup, destroyedAfterSignal)
+{
+    /// Arrange
+    auto signal = std::make_unique<Signal<void()>>();
+    ConnectionGroup group{};
+    group.add(signal->connect([]() {}));
+
+    /// Act
+    signal.reset();
+    group.disconnect();
+
+    /// Assert
+    ASSERT_TRUE(group.empty());
+}
+
+TEST(ConnectionGroup, dropsConnectionsDisconnectedElsewhere)
+{
+    /// Arrange
+    Signal<void()> signal{};
+    ConnectionGroup group{};
+
+    /// Act
+    for (auto i = 0; i < 1000; ++i) {
+        auto connection = signal.connect([]() {});
+        group.add(connection);
+        connection.disconnect();
+    }
+
+    /// Assert
+    ASSERT_LT(group.size(), 32u);
+}
+
+} // namespace moment
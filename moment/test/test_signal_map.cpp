@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <moment/SignalMap.hpp>
+
+namespace moment {
+
+using namespace testing;
+
+TEST(SignalMap, emitCallsOnlySlotsOfKey)
+{
+    /// Arrange
+    SignalMap<std::string, void(int)> map{};
+    auto orders = 0;
+    auto trades = 0;
+    map.connect("orders", [&orders](int value) { orders += value; });
+    map.connect("trades", [&trades](int value) { trades += value; });
+
+    /// Act
+    map("orders", 2);
+    map.emit("quotes", 4);
+
+    /// Assert
+    ASSERT_EQ(orders, 2);
+    ASSERT_EQ(trades, 0);
+    ASSERT_EQ(map.size(), 2u);
+}
+
+TEST(SignalMap, connectAllCalledForEveryKeyAfterSlotsOfKey)
+{
+    /// Arrange
+    SignalMap<int, void(int)> map{};
+    auto calls = std::vector<std::pair<int, int>>{};
+    map.connect(1, [&calls](int value) { calls.emplace_back(-1, value); });
+    map.connectAll([&calls](const int& key, int value) { calls.emplace_back(key, value); });
+
+    /// Act
+    map(1, 10);
+    map(2, 20);
+
+    /// Assert
+    ASSERT_THAT(calls, ElementsAre(Pair(-1, 10), Pair(1, 10), Pair(2, 20)));
+}
+
+TEST(SignalMap, disconnectedSlotNotCalled)
+{
+    /// Arrange
+    SignalMap<int, void()> map{};
+    auto calls = 0;
+    auto connection = map.connect(1, [&calls]() { ++calls; });
+    auto wildcard = map.connectAll([&calls](const int&) { ++calls; });
+
+    /// Act
+    const auto disconnected = connection.disconnect();
+    wildcard.disconnect();
+    map(1);
+
+    /// Assert
+    ASSERT_TRUE(disconnected);
+    ASSERT_FALSE(connection.valid());
+    ASSERT_EQ(calls, 0);
+}
+
+TEST(SignalMap, manyKeysEachCalledOnce)
+{
+    /// Arrange
+    constexpr auto keyCount = 1000;
+    SignalMap<int, void(int&), single_threaded> map{};
+    auto connections = std::vector<Connection<void(int&), single_threaded>>{};
+    for (auto key = 0; key < keyCount; ++key) {
+        connections.push_back(map.connect(key, [key](int& total) { total += key; }));
+    }
+
+    /// Act
+    auto total = 0;
+    for (auto key = 0; key < keyCount; ++key) {
+        map(key, total);
+    }
+
+    /// Assert
+    ASSERT_EQ(total, keyCount * (keyCount - 1) / 2);
+    ASSERT_EQ(map.size(), static_cast<std::size_t>(keyCount));
+}
+
+TEST(SignalMap, concurrentConnectNewKeysAndEmit)
+{
+    /// Arrange
+    constexpr auto threadCount = 4;
+    constexpr auto keysPerThread = 500;
+    SignalMap<int, void(int)> map{};
+    auto total = std::atomic<int>{0};
+    map.connect(-1, [&total](int value) { total += value; });
+    auto threads = std::vector<std::thread>{};
+
+    /// Act
+    for (auto t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&map, t]() {
+            for (auto i = 0; i < keysPerThread; ++i) {
+                map.connect(t * keysPerThread + i, [](int) {});
+                map(-1, 1);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    /// Assert
+    ASSERT_EQ(total, threadCount * keysPerThread);
+    ASSERT_EQ(map.size(), static_cast<std::size_t>(threadCount * keysPerThread + 1));
+}
+
+TEST(SignalMap, compactRemovesKeysWithoutConnections)
+{
+    /// Arrange
+    constexpr auto keyCount = 1000;
+    SignalMap<int, void(int&), single_threaded> map{};
+    auto connections = std::vector<Connection<void(int&), single_threaded>>{};
+    for (auto key = 0; key < keyCount; ++key) {
+        connections.push_back(map.connect(key, [key](int& total) { total += key; }));
+    }
+    for (auto key = 1; key < keyCount; ++key) {
+        connections[key].disconnect();
+    }
+
+    /// Act
+    const auto sizeBefore = map.size();
+    const auto removed = map.compact();
+    auto total = 0;
+    map(0, total);
+    map(1, total);
+    map.connect(1, [](int& total) { total += 10; });
+    map(1, total);
+
+    /// Assert
+    ASSERT_EQ(sizeBefore, static_cast<std::size_t>(keyCount));
+    ASSERT_EQ(removed, static_cast<std::size_t>(keyCount - 1));
+    ASSERT_EQ(total, 10);
+    ASSERT_EQ(map.size(), 2u);
+    ASSERT_EQ(map.compact(), 0u);
+}
+
+TEST(SignalMap, compactFromSlotOfRemovedKey)
+{
+    /// Arrange
+    SignalMap<int, void()> map{};
+    auto calls = 0;
+    auto connection = Connection<void()>{};
+    connection = map.connect(1, [&map, &connection, &calls]() {
+        ++calls;
+        connection.disconnect();
+        map.compact();
+    });
+    map.connectAll([&calls](const int&) { ++calls; });
+
+    /// Act
+    map(1);
+    map(1);
+
+    /// Assert
+    ASSERT_EQ(calls, 3);
+    ASSERT_EQ(map.size(), 0u);
+}
+
+} // namespace moment
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+#include <vector>
+
+#include <moment/StaticSignal.hpp>
+
+namespace moment {
+
+using namespace testing;
+
+namespace {
+
+std::vector<std::string> calls{};
+
+void freeSlot(int value)
+{
+    calls.push_back("free " + std::to_string(value));
+}
+
+struct Receiver {
+    void onEvent(int value) { calls.push_back("member " + std::to_string(value)); }
+    int twice(int value) { return 2 * value; }
+};
+
+} // namespace
+
+TEST(StaticSignal, callsSlotsInOrder)
+{
+    /// Arrange
+    calls.clear();
+    Receiver receiver{};
+    auto sig = makeStaticSignal<void(int)>(StaticSlot<&freeSlot>{},
+                                           StaticSlot<&Receiver::onEvent>{&receiver},
+                                           [](int value) { calls.push_back("lambda " + std::to_string(value)); });
+
+    /// Act
+    sig(1);
+
+    /// Assert
+    ASSERT_EQ(sig.size(), 3u);
+    ASSERT_THAT(calls, ElementsAre("free 1", "member 1", "lambda 1"));
+}
+
+TEST(StaticSignal, slotsStoredWithoutErasure)
+{
+    /// Arrange
+    using Sig = StaticSignal<void(int), StaticSlot<&freeSlot>, StaticSlot<&Receiver::onEvent>>;
+
+    /// Act
+    constexpr auto size = sizeof(Sig);
+
+    /// Assert
+    ASSERT_EQ(size, sizeof(Receiver*));
+}
+
+TEST(StaticSignal, handledStopsAtFirstHandledSlot)
+{
+    /// Arrange
+    auto visited = std::vector<int>{};
+    auto sig = makeStaticSignal<Handled(int)>(
+        [&visited](int) {
+            visited.push_back(0);
+            return Handled::No;
+        },
+        [&visited](int) {
+            visited.push_back(1);
+            return Handled::Yes;
+        },
+        [&visited](int) {
+            visited.push_back(2);
+            return Handled::No;
+        });
+
+    /// Act
+    const auto handled = sig(1);
+
+    /// Assert
+    ASSERT_EQ(handled, Handled::Yes);
+    ASSERT_THAT(visited, ElementsAre(0, 1));
+}
+
+TEST(StaticSignal, emitCombinedSum)
+{
+    /// Arrange
+    Receiver receiver{};
+    auto sig = makeStaticSignal<int(int)>(StaticSlot<&Receiver::twice>{&receiver}, [](int value) { return value; });
+
+    /// Act
+    const auto total = sig.emitCombined(sum<int>{}, 3);
+
+    /// Assert
+    ASSERT_EQ(total, 9);
+}
+
+} // namespace moment
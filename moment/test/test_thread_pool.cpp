@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <moment/ThreadPool.hpp>
+
+namespace moment {
+
+using namespace testing;
+
+TEST(ThreadPool, postRunsOnWorker)
+{
+    /// Arrange
+    ThreadPool pool{2u};
+    Latch done{1u};
+    auto workerId = std::thread::id{};
+
+    /// Act
+    pool.post([&workerId, &done]() {
+        workerId = std::this_thread::get_id();
+        done.countDown();
+    });
+    done.wait();
+
+    /// Assert
+    ASSERT_NE(workerId, std::this_thread::get_id());
+}
+
+TEST(ThreadPool, destructorRunsPendingTasks)
+{
+    /// Arrange
+    auto count = std::atomic<int>{0};
+    auto pool = std::make_unique<ThreadPool>(1u);
+    for (auto i = 0; i < 100; ++i) {
+        pool->post([&count]() { ++count; });
+    }
+
+    /// Act
+    pool.reset();
+
+    /// Assert
+    ASSERT_EQ(count, 100);
+}
+
+TEST(ThreadPool, finishedTaskReleasesCaptures)
+{
+    /// Arrange
+    ThreadPool pool{1u};
+    Latch done{1u};
+    auto resource = std::make_shared<int>(0);
+    const auto weak = std::weak_ptr<int>{resource};
+    pool.post([resource = std::move(resource), &done]() { done.countDown(); });
+
+    /// Act
+    done.wait();
+    /// The worker destroys the task right after it returns, give it a moment to get there
+    for (auto i = 0; i < 1000 && !weak.expired(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    /// Assert
+    ASSERT_TRUE(weak.expired());
+}
+
+TEST(Latch, waitReleasedAfterCountDown)
+{
+    /// Arrange
+    Latch latch{2u};
+    auto counted = std::atomic<int>{0};
+    auto counter = std::thread{[&latch, &counted]() {
+        for (auto i = 0; i < 2; ++i) {
+            ++counted;
+            latch.countDown();
+        }
+    }};
+
+    /// Act
+    latch.wait();
+
+    /// Assert
+    ASSERT_EQ(counted, 2);
+    counter.join();
+}
+
+} // namespace moment
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <functional>
+#include <memory>
+
+#include <moment/Trackable.hpp>
+
+namespace moment {
+
+using namespace testing;
+
+namespace {
+
+struct Receiver : Trackable {
+    void onEvent(int value) { sum += value; }
+
+    int sum{0};
+};
+
+} // namespace
+
+TEST(Trackable, disconnectsWhenDestroyed)
+{
+    /// Arrange
+    Signal<void(int)> signal{};
+    auto receiver = std::make_unique<Receiver>();
+    auto connection = signal.connect(receiver.get(), &Receiver::onEvent);
+    signal(1);
+    ASSERT_EQ(receiver->sum, 1);
+
+    /// Act
+    receiver.reset();
+    signal(2);
+
+    /// Assert
+    ASSERT_FALSE(connection.valid());
+}
+
+TEST(Trackable, disconnectsMemFnConnection)
+{
+    /// Arrange
+    Signal<void(int), single_threaded> signal{};
+    auto receiver = std::make_unique<Receiver>();
+    auto connection = signal.connect(receiver.get(), std::mem_fn<void(int)>(&Receiver::onEvent));
+
+    /// Act
+    receiver.reset();
+    signal(1);
+
+    /// Assert
+    ASSERT_FALSE(connection.valid());
+}
+
+TEST(Trackable, disconnectTracked)
+{
+    /// Arrange
+    Signal<void(int)> first{};
+    Signal<void(int)> second{};
+    Receiver receiver;
+    first.connect(&receiver, &Receiver::onEvent);
+    second.connect(&receiver, &Receiver::onEvent);
+
+    /// Act
+    receiver.disconnectTracked();
+    first(1);
+    second(1);
+
+    /// Assert
+    ASSERT_EQ(receiver.sum, 0);
+}
+
+TEST(Trackable, copyDoesNotShareConnections)
+{
+    /// Arrange
+    Signal<void(int)> signal{};
+    Receiver receiver;
+    auto connection = signal.connect(&receiver, &Receiver::onEvent);
+
+    /// Act
+    {
+        Receiver copy{receiver};
+    }
+    signal(1);
+
+    /// Assert
+    ASSERT_TRUE(connection.valid());
+    ASSERT_EQ(receiver.sum, 1);
+}
+
+TEST(Trackable, destroyedAfterSignal)
+{
+    /// Arrange
+    auto signal = std::make_unique<Signal<void(int)>>();
+    auto receiver = std::make_unique<Receiver>();
+    signal->connect(receiver.get(), &Receiver::onEvent);
+
+    /// Act
+    signal.reset();
+    receiver.reset();
+
+    /// Assert
+    ASSERT_FALSE(signal);
+}
+
+} // namespace moment